@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Throughput of the analysis of many tiny random models: through InputProblem
+ * with the sparse engine, with the (automatically chosen) dense engine, and
+ * through daestruct_analyse_dense, which does not build a sigma_matrix at all,
+ * and through daestruct_analyse_batch on all models at once.
+ * usage: denseBenchmarkExample <models> <dimension>
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <daestruct.h>
+#include <daestruct/analysis.hpp>
+
+using namespace daestruct::analysis;
+
+static long checksum = 0;
+
+static void analyse(const std::vector<int>& derivatives, int n, bool dense) {
+  InputProblem problem(n);
+  problem.options.dense = dense;
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+      if (derivatives[i * n + j] >= 0)
+	problem.sigma.insert(i, j, -derivatives[i * n + j]);
+  const AnalysisResult result = problem.pryceAlgorithm();
+  checksum += result.c[0] + result.d[n - 1];
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: %s <models> <dimension>\n", argv[0]);
+    return 1;
+  }
+
+  const int models = std::atoi(argv[1]);
+  const int n = std::atoi(argv[2]);
+
+  /* every equation has a transversal entry and about three more */
+  std::mt19937 gen(0);
+  std::vector<std::vector<int>> problems(models, std::vector<int>(n * n, -1));
+  std::vector<int> perm(n);
+  for (auto& derivatives : problems) {
+    for (int k = 0; k < n; k++)
+      perm[k] = k;
+    std::shuffle(perm.begin(), perm.end(), gen);
+    for (int i = 0; i < n; i++) {
+      derivatives[i * n + perm[i]] = gen() % 3;
+      for (int k = 0; k < 3; k++)
+	derivatives[i * n + gen() % n] = gen() % 3;
+    }
+  }
+
+  /* the analysis reports its progress on stdout */
+  std::cout.setstate(std::ios::badbit);
+
+  std::vector<int> packed;
+  for (const auto& derivatives : problems)
+    packed.insert(packed.end(), derivatives.begin(), derivatives.end());
+
+  const char* names[] = { "sparse", "dense", "dense C", "batch C" };
+  for (int engine = 0; engine < 4; engine++) {
+    checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    if (engine < 2) {
+      for (const auto& derivatives : problems)
+	analyse(derivatives, n, engine == 1);
+    } else if (engine == 3) {
+      std::vector<int> c(models * n), d(models * n), status(models);
+      daestruct_analyse_batch(models, n, packed.data(), c.data(), d.data(), status.data());
+      for (int k = 0; k < models; k++)
+	checksum += c[k * n] + d[k * n + n - 1];
+    } else {
+      std::vector<int> c(n), d(n);
+      for (const auto& derivatives : problems) {
+	daestruct_analyse_dense(n, derivatives.data(), c.data(), d.data());
+	checksum += c[0] + d[n - 1];
+      }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "%-8s %8.3fs  %10.0f models/s  (checksum %ld)\n", names[engine], seconds, models / seconds, checksum);
+  }
+  return 0;
+}
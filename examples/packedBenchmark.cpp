@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Memory and time of lap() and the offset fixpoint on a band model in the
+ * plain (sigma_matrix), narrow (compact_sigma_matrix) and varint compressed
+ * (packed_sigma_matrix) representations.
+ * usage: packedBenchmarkExample <dimension> [shuffle]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <daestruct/analysis.hpp>
+#include <daestruct/packed_sigma_matrix.hpp>
+#include <lap.hpp>
+
+using namespace daestruct;
+
+typedef std::vector<std::vector<std::pair<int, int>>> rows_type;
+
+template<typename Matrix>
+static void measure(const char* name, const Matrix& sigma, std::size_t bytes) {
+  const auto start = std::chrono::steady_clock::now();
+  const solution assignment = lap(sigma);
+  const auto assigned = std::chrono::steady_clock::now();
+
+  std::vector<int> c(sigma.dimension, 0), d(sigma.dimension, 0);
+  analysis::solveByFixedPoint(assignment.rowsol, sigma, c, d);
+  const auto solved = std::chrono::steady_clock::now();
+
+  std::fprintf(stderr, "%-8s %10.1f MB  lap %7.3fs  fixpoint %7.3fs  (cost %lld)\n", name, bytes / 1e6,
+	       std::chrono::duration<double>(assigned - start).count(),
+	       std::chrono::duration<double>(solved - assigned).count(), static_cast<long long>(assignment.cost));
+}
+
+template<typename Matrix>
+static Matrix build(const rows_type& rows) {
+  Matrix sigma(rows.size());
+  for (unsigned int i = 0; i < rows.size(); i++)
+    for (const auto& entry : rows[i])
+      sigma.insert(i, entry.first, entry.second);
+  return sigma;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <dimension> [shuffle]\n", argv[0]);
+    return 1;
+  }
+
+  const int n = std::atoi(argv[1]);
+  const bool shuffle = argc > 2 && std::atoi(argv[2]);
+
+  std::mt19937 gen(0);
+  std::vector<int> perm(n);
+  for (int k = 0; k < n; k++)
+    perm[k] = k;
+  if (shuffle)
+    std::shuffle(perm.begin(), perm.end(), gen);
+
+  /* every equation contains its neighbours within distance 3, up to the second derivative */
+  rows_type rows(n);
+  for (int i = 0; i < n; i++) {
+    for (int j = std::max(0, i - 3); j <= std::min(n - 1, i + 3); j++)
+      if (j == i || gen() % 2)
+	rows[i].push_back(std::make_pair(perm[j], -(int)(gen() % 3)));
+    std::sort(rows[i].begin(), rows[i].end());
+  }
+
+  std::size_t nnz = 0;
+  for (const auto& row : rows)
+    nnz += row.size();
+
+  {
+    const sigma_matrix sigma = build<sigma_matrix>(rows);
+    measure("plain", sigma, nnz * (sizeof(int) + sizeof(std::size_t)) + (n + 1) * sizeof(std::size_t));
+  }
+  {
+    const compact_sigma_matrix sigma = build<compact_sigma_matrix>(rows);
+    measure("compact", sigma, nnz * (sizeof(int8_t) + sizeof(uint32_t)) + (n + 1) * sizeof(uint32_t));
+  }
+  {
+    const packed_sigma_matrix sigma(build<compact_sigma_matrix>(rows));
+    measure("packed", sigma, sigma.bytes());
+  }
+  return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Time and cache misses of the analysis of a randomly numbered large circuit
+ * (see circuit.h), in the original and in reverse Cuthill-McKee order.
+ * usage: reorderBenchmarkExample <sub-circuits> [seed]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <daestruct/analysis.hpp>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace daestruct::analysis;
+
+/* hardware cache miss counter of this process, -1 if perf events are not available */
+struct CacheMisses {
+  int fd;
+
+  CacheMisses() : fd(-1) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~CacheMisses() {
+#ifdef __linux__
+    if (fd >= 0)
+      close(fd);
+#endif
+  }
+
+  void start() {
+#ifdef __linux__
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  long long stop() {
+    long long count = -1;
+#ifdef __linux__
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd, &count, sizeof(count)) != sizeof(count))
+	count = -1;
+    }
+#endif
+    return count;
+  }
+};
+
+/* the closed circuit of circuit.h with equations and unknowns numbered randomly */
+static void setShuffledCircuit(InputProblem& p, int n, unsigned int seed) {
+  const int dimension = 2 + 8 * n;
+  std::vector<int> eq(dimension), un(dimension);
+  for (int k = 0; k < dimension; k++)
+    eq[k] = un[k] = k;
+  std::mt19937 gen(seed);
+  std::shuffle(eq.begin(), eq.end(), gen);
+  std::shuffle(un.begin(), un.end(), gen);
+
+  std::vector<std::vector<std::pair<int, int>>> rows(dimension);
+  auto set = [&](int variable, int equation, int derivative) {
+    rows[eq[equation]].push_back(std::make_pair(un[variable], -derivative));
+  };
+
+  set(0, 0, 0);
+  set(0, 1, 0);
+  for (int j = 0; j < n; j++) {
+    const int e = 2 + 8 * j, u = 2 + 8 * j;
+    const int u1 = u, u2 = u + 1, uL = u + 2, i1 = u + 3, i2 = u + 4, iL = u + 5, uC = u + 6, iC = u + 7;
+    set(u1, e, 0); set(i1, e, 0);
+    set(u2, e + 1, 0); set(i2, e + 1, 0);
+    set(uL, e + 2, 0); set(iL, e + 2, 1);
+    set(i1, e + 3, 0); set(i2, e + 3, 0); set(iL, e + 3, 0);
+    set(uL, e + 4, 0); set(u2, e + 4, 0);
+    set(iC, e + 5, 0); set(uC, e + 5, 1);
+    set(uC, e + 6, 0); set(u1, e + 6, 0); set(u2, e + 6, 0);
+    set(1, e + 7, 0); set(i1, e + 7, 0); set(iC, e + 7, 0);
+    set(u1, 1, 0); set(uL, 1, 0);
+  }
+
+  for (int i = 0; i < dimension; i++) {
+    std::sort(rows[i].begin(), rows[i].end());
+    for (const auto& entry : rows[i])
+      p.sigma.insert(i, entry.first, entry.second);
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <sub-circuits> [seed]\n", argv[0]);
+    return 1;
+  }
+
+  const int n = std::atoi(argv[1]);
+  const unsigned int seed = argc > 2 ? std::atoi(argv[2]) : 0;
+
+  InputProblem problem(2 + 8 * n);
+  setShuffledCircuit(problem, n, seed);
+  /* measure the LAP itself */
+  problem.options.eliminate = false;
+  problem.options.fast_path = false;
+
+  CacheMisses misses;
+  for (int reorder = 0; reorder < 2; reorder++) {
+    problem.options.reorder = reorder;
+
+    const auto start = std::chrono::steady_clock::now();
+    misses.start();
+    const AnalysisResult result = problem.assign();
+    const long long count = misses.stop();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::fprintf(stderr, "%-10s assignment: %8.3fs, cache misses: %lld\n",
+		 reorder ? "rcm" : "original", seconds, count);
+  }
+  return 0;
+}
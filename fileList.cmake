@@ -9,11 +9,29 @@ set(hdrs ${hdrs_dir}/daestruct.hpp)
 
 #Project source files
 set(srcs ${srcs_dir}/analysis.cpp 
+         ${srcs_dir}/analysis_plan.cpp
+         ${srcs_dir}/batch_assignment.cpp
+         ${srcs_dir}/blt.cpp
+         ${srcs_dir}/dense_assignment.cpp
+         ${srcs_dir}/differentiated_system.cpp
+         ${srcs_dir}/dummy_derivatives.cpp
+         ${srcs_dir}/elimination.cpp
          ${srcs_dir}/lap.cpp
+         ${srcs_dir}/lap_solver.cpp
+         ${srcs_dir}/matching.cpp
+         ${srcs_dir}/partial_analysis.cpp
+         ${srcs_dir}/reordering.cpp
+         ${srcs_dir}/result_cache.cpp
+         ${srcs_dir}/session.cpp
+         ${srcs_dir}/tearing.cpp
+         ${srcs_dir}/solution_scheme.cpp
+         ${srcs_dir}/composite.cpp
          ${srcs_dir}/daestruct.cpp
          ${srcs_dir}/timer.cpp
          ${srcs_dir}/variable_analysis.cpp
+         ${srcs_dir}/symmetry.cpp
          ${srcs_dir}/variable_structure.cpp
+         ${srcs_dir}/warm_start.cpp
 )
 
 #Project tests
@@ -21,11 +39,34 @@ set(test_sources ${tests_dir}/boostTests.cpp
   ${tests_dir}/pendulumAnalysis.cpp 
   ${tests_dir}/circuitAnalysis.cpp 
   ${tests_dir}/test_lap.cpp 
+  ${tests_dir}/resultCache.cpp
+  ${tests_dir}/sessionTests.cpp
+  ${tests_dir}/eliminationTests.cpp
+  ${tests_dir}/fastPathTests.cpp
+  ${tests_dir}/singularityTests.cpp
+  ${tests_dir}/partialAnalysisTests.cpp
+  ${tests_dir}/bltTests.cpp
+  ${tests_dir}/differentiatedSystemTests.cpp
+  ${tests_dir}/solutionSchemeTests.cpp
+  ${tests_dir}/dummyDerivativeTests.cpp
+  ${tests_dir}/tearingTests.cpp
+  ${tests_dir}/compositeTests.cpp
+  ${tests_dir}/symmetryTests.cpp
+  ${tests_dir}/analysisPlanTests.cpp
+  ${tests_dir}/reorderingTests.cpp
+  ${tests_dir}/denseTests.cpp
+  ${tests_dir}/lapSolverTests.cpp
   )
 
+#compile time analysis tests, built as C++17
+set(static_test_sources ${tests_dir}/staticAnalysisTests.cpp)
+
 #examples
 set(pendulum_example_sources ${examples_dir}/pendulum.c)
 set(largeCircuit_example_sources ${examples_dir}/largeCircuit.c)
 set(switchableCircuit_example_sources ${examples_dir}/largeSwitchCircuit.c)
+set(reorderBenchmark_example_sources ${examples_dir}/reorderBenchmark.cpp)
+set(packedBenchmark_example_sources ${examples_dir}/packedBenchmark.cpp)
+set(denseBenchmark_example_sources ${examples_dir}/denseBenchmark.cpp)
 
 
@@ -19,6 +19,8 @@
 #ifndef DAESTRUCT_H
 #define DAESTRUCT_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -48,9 +50,55 @@ extern "C" {
   /**
    * actually run the structural analysis
    * the returned pointer must be deleted with daestruct_result_delete
+   * returns NULL if the problem is structurally singular, the Dulmage-Mendelsohn
+   * breakdown (over-, under- and well-determined parts) is written to stderr
    */
   struct daestruct_result* daestruct_analyse(struct daestruct_input* problem);
 
+  /**
+   * analyse a problem of at most 64 equations without creating an input problem,
+   * derivatives[equation * dimension + variable] is the highest derivative of variable
+   * in equation, or negative if the variable does not occur.
+   * the offsets are written to c[0 .. dimension - 1] and d[0 .. dimension - 1]
+   * returns 0, or -1 if the problem is structurally singular or too large
+   */
+  int daestruct_analyse_dense(int dimension, const int* derivatives, int* c, int* d);
+
+  /**
+   * analyse @count problems of the same @dimension (at most 64) in lockstep, several per SIMD register.
+   * derivatives holds the problems one after the other, each laid out as for daestruct_analyse_dense,
+   * c and d receive the offsets in the same packed order (count * dimension entries each),
+   * status[k] is 0, or -1 if problem k is structurally singular (its offsets are undefined then)
+   * returns the number of singular problems, or -1 if the dimension is too large
+   */
+  int daestruct_analyse_batch(int count, int dimension, const int* derivatives, int* c, int* d, int* status);
+
+  /**
+   * hands out the @return entries of @equation: the variables at *variables and their highest
+   * derivatives at *derivatives, both arrays have to stay valid during the analysis
+   */
+  typedef int (*daestruct_row_callback)(void* data, int equation, const int** variables, const int** derivatives);
+
+  /**
+   * analyse a problem in the caller's own representation, the equations are read in place
+   * through @rows (called with @data), without building an input problem.
+   * the offsets are written to c[0 .. dimension - 1] and d[0 .. dimension - 1]
+   * returns 0, or -1 if the problem is structurally singular or refers to a variable outside [0, dimension)
+   */
+  int daestruct_analyse_rows(int dimension, daestruct_row_callback rows, void* data, int* c, int* d);
+
+  /**
+   * like daestruct_analyse, but give up as soon as the offset of some equation
+   * provably exceeds @max_offset (see daestruct_result_bound_witness)
+   */
+  struct daestruct_result* daestruct_analyse_bounded(struct daestruct_input* problem, int max_offset);
+
+  /**
+   * the equation whose offset exceeds the bound of daestruct_analyse_bounded
+   * or -1 if the analysis completed, the derivation indices are incomplete otherwise
+   */
+  int daestruct_result_bound_witness(struct daestruct_result* result);
+
   /**
    * get the derivation index
    */
@@ -61,6 +109,38 @@ extern "C" {
    */
   int daestruct_result_variable_index(struct daestruct_result* result, int variable);
 
+  /**
+   * request the block lower triangular form of the system Jacobian from daestruct_analyse
+   */
+  void daestruct_input_enable_blt(struct daestruct_input* problem, int enable);
+
+  /**
+   * let daestruct_analyse solve replicated sub-models (equal up to an index shift) only once
+   */
+  void daestruct_input_enable_symmetry(struct daestruct_input* problem, int enable);
+
+  /**
+   * let daestruct_analyse solve the assignment problem in a bandwidth reducing order
+   */
+  void daestruct_input_enable_reordering(struct daestruct_input* problem, int enable);
+
+  /**
+   * the number of BLT blocks (0 if not requested)
+   */
+  int daestruct_result_blt_blocks(struct daestruct_result* result);
+
+  /**
+   * the BLT blocks in solving order: block b consists of the positions
+   * block_start[b] .. block_start[b+1] - 1 of the equation and variable arrays,
+   * equations[k] is solved for variables[k]
+   * the arrays are owned by the result
+   */
+  const int* daestruct_result_blt_block_start(struct daestruct_result* result);
+
+  const int* daestruct_result_blt_equations(struct daestruct_result* result);
+
+  const int* daestruct_result_blt_variables(struct daestruct_result* result);
+
   /**
    * delete the given result description
    */
@@ -21,34 +21,187 @@
 
 #include <vector>
 #include <functional>
+#include <stdexcept>
 #include <boost/variant.hpp>
 
 #include <daestruct/sigma_matrix.hpp>
+#include <daestruct/packed_sigma_matrix.hpp>
+#include <daestruct/csr_matrix.hpp>
+#include <daestruct/row_matrix.hpp>
 
 namespace daestruct {
   namespace analysis {
 
     using namespace std;
 
+    /**
+     * Pryce's fixpoint for the smallest offsets of an optimal assignment on a row matrix
+     * (see row_matrix.hpp), instantiated for sigma_matrix, compact_sigma_matrix,
+     * packed_sigma_matrix, csr_matrix and callback_matrix
+     */
+    template<typename Matrix>
     void solveByFixedPoint(const std::vector<int>& assignment,  
-			   const sigma_matrix& sigma,
+			   const Matrix& sigma,
 			   std::vector<int>& c, std::vector<int>& d);
 
+    /**
+     * Like solveByFixedPoint, but stops as soon as some c[i] exceeds max_offset.
+     * c only grows during the iteration, so that equation is a witness for the
+     * canonical offset exceeding the bound. Returns the witness or -1.
+     */
+    template<typename Matrix>
+    int solveByFixedPoint(const std::vector<int>& assignment,
+			  const Matrix& sigma,
+			  std::vector<int>& c, std::vector<int>& d, int max_offset);
+
+    extern template void solveByFixedPoint(const std::vector<int>&, const sigma_matrix&, std::vector<int>&, std::vector<int>&);
+    extern template void solveByFixedPoint(const std::vector<int>&, const compact_sigma_matrix&, std::vector<int>&, std::vector<int>&);
+    extern template int solveByFixedPoint(const std::vector<int>&, const sigma_matrix&, std::vector<int>&, std::vector<int>&, int);
+    extern template int solveByFixedPoint(const std::vector<int>&, const compact_sigma_matrix&, std::vector<int>&, std::vector<int>&, int);
+    extern template void solveByFixedPoint(const std::vector<int>&, const packed_sigma_matrix&, std::vector<int>&, std::vector<int>&);
+    extern template int solveByFixedPoint(const std::vector<int>&, const packed_sigma_matrix&, std::vector<int>&, std::vector<int>&, int);
+    extern template void solveByFixedPoint(const std::vector<int>&, const csr_matrix&, std::vector<int>&, std::vector<int>&);
+    extern template int solveByFixedPoint(const std::vector<int>&, const csr_matrix&, std::vector<int>&, std::vector<int>&, int);
+    extern template void solveByFixedPoint(const std::vector<int>&, const callback_matrix&, std::vector<int>&, std::vector<int>&);
+    extern template int solveByFixedPoint(const std::vector<int>&, const callback_matrix&, std::vector<int>&, std::vector<int>&, int);
+
+    /**
+     * Dulmage-Mendelsohn decomposition of the incidence of sigma
+     */
+    struct DulmageMendelsohn {
+      /* size of a maximum matching of equations and unknowns */
+      long rank;
+
+      /* equations and unknowns reachable by alternating paths from an unmatched equation */
+      std::vector<int> over_equations;
+      std::vector<int> over_variables;
+
+      /* equations and unknowns reachable by alternating paths from an unmatched unknown */
+      std::vector<int> under_equations;
+      std::vector<int> under_variables;
+
+      /* the structurally nonsingular rest */
+      std::vector<int> well_equations;
+      std::vector<int> well_variables;
+    };
+
+    /**
+     * Decompose sigma in O(nnz sqrt(n)), sigma is structurally nonsingular iff rank == dimension
+     */
+    DulmageMendelsohn dulmageMendelsohn(const sigma_matrix& sigma);
+
+    /**
+     * Thrown by the analysis of a structurally singular problem
+     */
+    class StructurallySingular : public std::runtime_error {
+    public:
+      const DulmageMendelsohn decomposition;
+
+      StructurallySingular(const DulmageMendelsohn& dm);
+    };
+
+    struct AnalysisOptions {
+      /* eliminate forced assignments and contract two-unknown equations before solving the LAP */
+      bool eliminate;
+
+      /* try to prove c = 0 by a matching on the highest derivatives before solving any LAP */
+      bool fast_path;
+
+      /* stop the analysis as soon as an equation offset provably exceeds this, -1 for no bound */
+      int max_offset;
+
+      /* compute the block lower triangular form of the system Jacobian */
+      bool blt;
+
+      /* detect sub-models replicated up to an index shift and solve the LAP of one representative each */
+      bool symmetry;
+
+      /* solve the LAP in reverse Cuthill-McKee order of equations and unknowns */
+      bool reorder;
+
+      /* solve problems of dimension up to 64 by a dense Hungarian method in stack storage,
+	 and nearly dense ones (see dense_lap_density) by the dense LAP kernel */
+      bool dense;
+
+      AnalysisOptions() : eliminate(true), fast_path(true), max_offset(-1), blt(false), symmetry(false), reorder(false),
+			  dense(true) {}
+    };
+
+    struct AnalysisStats {
+      /* dimension of the assignment problem actually handed to lap() */
+      long lap_dimension;
+
+      /* true if c = 0 was certified without a LAP */
+      bool fast_path;
+
+      /* rows whose assignment was copied from a replicated representative */
+      long replicated_rows;
+
+      /* true if the assignment was solved by the dense engine instead of lap() */
+      bool dense;
+
+      AnalysisStats() : lap_dimension(0), fast_path(false), replicated_rows(0), dense(false) {}
+    };
+
+    /**
+     * Block lower triangular form of the system Jacobian (the entries with d[j] - c[i] == derivative).
+     * equations[k] is solved for variables[k], block b consists of the positions
+     * block_start[b] .. block_start[b+1] - 1, blocks are in solving order.
+     */
+    struct BLT {
+      std::vector<int> equations;
+      std::vector<int> variables;
+      std::vector<int> block_start;
+
+      int blocks() const { return block_start.empty() ? 0 : block_start.size() - 1; }
+
+      int blockSize(int b) const { return block_start[b + 1] - block_start[b]; }
+    };
+
     struct AnalysisResult {
       std::vector<int> row_assignment;
       std::vector<int> col_assignment;
       
       std::vector<int> c;
       std::vector<int> d;
+
+      /* an equation whose offset exceeds options.max_offset or -1, c and d are incomplete then */
+      int bound_witness;
+
+      AnalysisStats stats;
+
+      /* only filled if options.blt is set */
+      BLT blt;
+
+      AnalysisResult() : bound_witness(-1) {}
     };
 
+    /**
+     * Tarjan's algorithm on the system Jacobian of an analysed problem
+     */
+    BLT bltDecomposition(const sigma_matrix& sigma, const AnalysisResult& result);
+
     struct InputProblem {
       long dimension;
       sigma_matrix sigma;
+      AnalysisOptions options;
   
       InputProblem(long d) : dimension(d), sigma(d) {}
 
+      /**
+       * run the analysis, throws StructurallySingular if there is no transversal
+       */
       AnalysisResult pryceAlgorithm() const;
+
+      /**
+       * only compute an optimal assignment (c and d are left empty, unless the index 0/1 check succeeds)
+       */
+      AnalysisResult assign() const;
+
+      /**
+       * compute the canonical offsets for the assignment in result
+       */
+      void solveOffsets(AnalysisResult& result) const;
     };
   }
 }
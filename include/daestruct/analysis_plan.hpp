@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_ANALYSIS_PLAN_HPP
+#define DAE_ANALYSIS_PLAN_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * Symbolic part of the analysis of all problems sharing one nonzero pattern.
+     *
+     * The plan stores the pattern in compressed row form and its block
+     * triangular form w.r.t. a maximum matching. An entry outside the diagonal
+     * blocks is in no perfect matching, hence the LAP of any values on this
+     * pattern splits into one independent LAP per block. execute() only needs the
+     * derivatives in the order of the compressed rows (see position()).
+     * A plan is immutable after construction, several threads may execute it
+     * concurrently, each with its own Workspace.
+     */
+    class AnalysisPlan {
+      int n;
+
+      /* compressed row storage, columns sorted within a row */
+      std::vector<int64_t> rowStart;
+      std::vector<int> column;
+
+      /* block triangular form, rows and columns of block b are blockRows / blockColumns[blockStart[b] ..] */
+      std::vector<int> blockStart;
+      std::vector<int> blockRows;
+      std::vector<int> blockColumns;
+
+      /* entries inside the diagonal blocks as (local row, local column, position), sorted per block */
+      std::vector<int64_t> blockEntryStart;
+      std::vector<int> blockEntryRow;
+      std::vector<int> blockEntryColumn;
+      std::vector<int64_t> blockEntry;
+
+      /* compressed rows of the blocks into the block entries, block b starts at blockRowStart[blockStart[b] + b] */
+      std::vector<int64_t> blockRowStart;
+
+      /* the largest blocks solved by lap() and by dense_lap() */
+      int largestSparseBlock;
+      int largestDenseBlock;
+
+    public:
+      /**
+       * scratch memory of one execution
+       */
+      struct Workspace {
+	/* position of the entry every equation is assigned to */
+	std::vector<int64_t> assignedEntry;
+
+	/* costs of the pattern (in plan order) and of the block entries */
+	std::vector<int> cost;
+	std::vector<int> blockCost;
+
+	/* row major costs of a nearly dense block */
+	std::vector<int> denseCost;
+
+	/* buffers of the sparse block LAPs and the solution of the current block */
+	struct Lap;
+	std::unique_ptr<Lap> lap;
+
+	Workspace();
+
+	/* sized for the largest blocks of plan, executing it does not allocate */
+	Workspace(const AnalysisPlan& plan);
+
+	Workspace(Workspace&&);
+	Workspace& operator=(Workspace&&);
+	~Workspace();
+      };
+
+      /**
+       * plan the analysis of the pattern of sigma (its values are ignored),
+       * throws StructurallySingular if the pattern has no perfect matching
+       */
+      AnalysisPlan(const sigma_matrix& pattern);
+
+      int dimension() const { return n; }
+
+      int64_t nnz() const { return column.size(); }
+
+      int blocks() const { return blockStart.size() - 1; }
+
+      /**
+       * position of the entry (equation, variable) in the values of execute(), -1 if it is not in the pattern
+       */
+      int64_t position(int equation, int variable) const;
+
+      /**
+       * the derivatives of sigma in the order of the plan, sigma must have the planned pattern
+       */
+      std::vector<int> values(const sigma_matrix& sigma) const;
+
+      /**
+       * assignment and canonical offsets of the derivatives in plan order
+       */
+      AnalysisResult execute(const std::vector<int>& derivatives, Workspace& workspace) const;
+
+      AnalysisResult execute(const std::vector<int>& derivatives) const;
+    };
+  }
+}
+
+#endif
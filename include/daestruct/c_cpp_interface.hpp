@@ -21,6 +21,9 @@
 
 #include <daestruct/analysis.hpp>
 #include <daestruct/variable_analysis.hpp>
+#include <daestruct/result_cache.hpp>
+#include <daestruct/solution_scheme.hpp>
+#include <daestruct/lap_solver.hpp>
 
 using namespace daestruct::analysis;
 
@@ -32,4 +35,10 @@ struct daestruct_diff : public StructChange {};
 
 struct daestruct_changed : public ChangedProblem {};
 
+struct daestruct_cache : public ResultCache {};
+
+struct daestruct_scheme : public SolutionScheme {};
+
+struct daestruct_lap_solver : public daestruct::LapSolver {};
+
 #endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_COMPOSITE_HPP
+#define DAE_COMPOSITE_HPP
+
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * The structure of a component type: equations over local variables and
+     * interface slots, which are bound to variables outside of the component
+     * on instantiation.
+     */
+    struct ComponentTemplate {
+      struct Entry {
+	int equation;
+	int variable;
+	int derivative;
+      };
+
+      int equations;
+      int variables;
+      int interfaces;
+
+      std::vector<Entry> local;
+      std::vector<Entry> interface;
+
+      ComponentTemplate(int eqs, int vars, int slots) : equations(eqs), variables(vars), interfaces(slots) {}
+
+      void set(int equation, int variable, int derivative) {
+	local.push_back(Entry{equation, variable, derivative});
+      }
+
+      void setInterface(int equation, int slot, int derivative) {
+	interface.push_back(Entry{equation, slot, derivative});
+      }
+    };
+
+    /**
+     * A model built from instances of component templates plus global equations and variables.
+     * Every template is analysed once (an optimal, possibly partial, assignment of its local
+     * equations with its duals). The global LAP starts from the union of these solutions
+     * and only augments the rows left free: the coupling equations and whatever the
+     * templates could not assign locally.
+     */
+    class CompositeProblem {
+      struct TemplateSolution {
+	std::vector<int> rowsol;
+	std::vector<int> u;
+	std::vector<int> v;
+      };
+
+      struct Instance {
+	int component;
+	int firstEquation;
+	int firstVariable;
+	std::vector<int> bindings;
+      };
+
+      std::vector<ComponentTemplate> templates;
+      std::vector<TemplateSolution> solutions;
+      std::vector<Instance> instances;
+      std::vector<ComponentTemplate::Entry> global;
+
+      int equationCount;
+      int variableCount;
+
+      const TemplateSolution& solve(int component);
+
+    public:
+      CompositeProblem() : equationCount(0), variableCount(0) {}
+
+      AnalysisOptions options;
+
+      int addTemplate(const ComponentTemplate& component);
+
+      /**
+       * instantiate a template, binding its interface slots to the given variables
+       * returns the instance id
+       */
+      int instantiate(int component, const std::vector<int>& bindings);
+
+      int addEquation() { return equationCount++; }
+
+      int addVariable() { return variableCount++; }
+
+      /**
+       * global ids of the local equations and variables of an instance
+       */
+      int equation(int instance, int local) const { return instances[instance].firstEquation + local; }
+
+      int variable(int instance, int local) const { return instances[instance].firstVariable + local; }
+
+      /**
+       * set the maximum derivative of a (global) variable in a (global) equation
+       */
+      void set(int equation, int variable, int derivative) {
+	global.push_back(ComponentTemplate::Entry{equation, variable, derivative});
+      }
+
+      int equations() const { return equationCount; }
+
+      int variables() const { return variableCount; }
+
+      /**
+       * the flat problem, for comparison or any of the other analyses
+       */
+      InputProblem flatten() const;
+
+      /**
+       * analyse the composite problem, throws StructurallySingular if it is not square and nonsingular
+       */
+      AnalysisResult analyse();
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DAESTRUCT_CSR_MATRIX_HPP
+#define DAESTRUCT_CSR_MATRIX_HPP
+
+#include <cstdint>
+
+#include <daestruct/sigma_matrix.hpp>
+
+namespace daestruct {
+
+  /**
+   * Read-only view of a square cost matrix in compressed sparse row form,
+   * the entries of row i are columns[row_start[i]] .. columns[row_start[i + 1] - 1]
+   * with the costs at the same positions. The columns of a row need not be
+   * sorted. The arrays are not copied and have to outlive the view, which is
+   * a row matrix (see row_matrix.hpp).
+   */
+  class csr_matrix {
+    const int64_t* row_start;
+    const int* columns;
+    const int* costs;
+
+  public:
+    int dimension;
+
+    /**
+     * iterator over the entries of one row
+     */
+    class const_iterator2 {
+      const csr_matrix* m;
+      int64_t pos;
+      int row;
+
+    public:
+      const_iterator2(const csr_matrix* matrix, int64_t p, int r) : m(matrix), pos(p), row(r) {}
+
+      int index1() const { return row; }
+      int index2() const { return m->columns[pos]; }
+      int operator*() const { return m->costs[pos]; }
+
+      const_iterator2& operator++() {
+	pos++;
+	return *this;
+      }
+
+      const_iterator2 operator++(int) {
+	const_iterator2 old(*this);
+	pos++;
+	return old;
+      }
+
+      bool operator==(const const_iterator2& o) const { return pos == o.pos; }
+      bool operator!=(const const_iterator2& o) const { return pos != o.pos; }
+    };
+
+    /**
+     * iterator over the rows, empty rows included
+     */
+    class const_iterator1 {
+      const csr_matrix* m;
+      int row;
+
+    public:
+      const_iterator1(const csr_matrix* matrix, int r) : m(matrix), row(r) {}
+
+      int index1() const { return row; }
+
+      const_iterator2 begin() const { return const_iterator2(m, m->row_start[row], row); }
+
+      const_iterator2 end() const { return const_iterator2(m, m->row_start[row + 1], row); }
+
+      const_iterator1& operator++() {
+	row++;
+	return *this;
+      }
+
+      const_iterator1 operator++(int) {
+	const_iterator1 old(*this);
+	row++;
+	return old;
+      }
+
+      bool operator==(const const_iterator1& o) const { return row == o.row; }
+      bool operator!=(const const_iterator1& o) const { return row != o.row; }
+    };
+
+    csr_matrix() : row_start(nullptr), columns(nullptr), costs(nullptr), dimension(0) {}
+
+    csr_matrix(int n, const int64_t* start, const int* cols, const int* values) :
+      row_start(start), columns(cols), costs(values), dimension(n) {}
+
+    const_iterator1 rowBegin() const { return const_iterator1(this, 0); }
+
+    const_iterator1 rowEnd() const { return const_iterator1(this, dimension); }
+
+    const_iterator1 findRow(int i) const { return const_iterator1(this, i); }
+
+    std::size_t nnz() const { return dimension > 0 ? row_start[dimension] - row_start[0] : 0; }
+
+    int operator()(const int i, const int j) const {
+      for (int64_t e = row_start[i]; e < row_start[i + 1]; e++)
+	if (columns[e] == j)
+	  return costs[e];
+      return BIG;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_DIFFERENTIATED_SYSTEM_HPP
+#define DAE_DIFFERENTIATED_SYSTEM_HPP
+
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * A sparsity pattern in compressed row form,
+     * the columns of row r are column[row_start[r]] .. column[row_start[r+1] - 1] (sorted)
+     */
+    struct SparsityPattern {
+      int rows;
+      int columns;
+      std::vector<int> row_start;
+      std::vector<int> column;
+
+      SparsityPattern() : rows(0), columns(0), row_start(1, 0) {}
+
+      int nnz() const { return column.size(); }
+    };
+
+    /**
+     * Stage k of Pryce's solution scheme: solve the equations f_i^(c_i + k)
+     * for the unknowns x_j^(d_j + k), for all i with c_i + k >= 0, j with d_j + k >= 0.
+     * Its Jacobian is the corresponding submatrix of the system Jacobian.
+     */
+    struct StageJacobian {
+      int k;
+
+      /* the active equations / unknowns, rows and columns of the pattern are numbered locally */
+      std::vector<int> equations;
+      std::vector<int> variables;
+      SparsityPattern pattern;
+    };
+
+    /**
+     * Structure of the index reduced system, i.e. all equations f_i^(q), q = 0..c_i
+     * in the unknowns x_j^(r), r = 0..d_j.
+     * Row equation_start[i] + q is f_i^(q), column variable_start[j] + r is x_j^(r).
+     */
+    struct DifferentiatedSystem {
+      std::vector<int> equation_start;
+      std::vector<int> variable_start;
+
+      /* f_i^(q) (generically) contains x_j^(r) for r <= derivative of x_j in f_i + q */
+      SparsityPattern incidence;
+
+      /* the system Jacobian, (i, j) is an entry iff x_j appears in f_i with derivative d_j - c_i */
+      SparsityPattern jacobian;
+
+      /* stages k = -max(d) .. 0 */
+      std::vector<StageJacobian> stages;
+    };
+
+    /**
+     * Derive the differentiated system from the canonical offsets of an analysis result
+     */
+    DifferentiatedSystem differentiatedSystem(const sigma_matrix& sigma, const AnalysisResult& result);
+  }
+}
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_DUMMY_DERIVATIVES_HPP
+#define DAE_DUMMY_DERIVATIVES_HPP
+
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * One step of the Mattsson-Soederlind dummy derivative selection within a BLT block.
+     * At level l, the equations with c_i >= l have to be differentiated (at least) l times,
+     * their Jacobian rows restricted to the candidate columns must provide a nonsingular
+     * square submatrix, the derivatives x_j^(d_j - l + 1) of the selected columns become
+     * dummy derivatives (i.e. algebraic variables).
+     */
+    struct DummyDerivativeLevel {
+      int block;
+      int level;
+
+      /* the equations with c_i >= level */
+      std::vector<int> equations;
+
+      /* the columns selected at the previous level (all block variables at level 1) present in these rows */
+      std::vector<int> candidates;
+
+      /*
+       * a structurally nonsingular square selection among the candidates: the columns
+       * of a matching of the equations in their Jacobian rows, in the order of the equations
+       */
+      std::vector<int> selected;
+    };
+
+    /**
+     * The dummy derivative levels of one block of result.blt, based on the
+     * assignment and the system Jacobian of the analysis
+     */
+    std::vector<DummyDerivativeLevel> dummyDerivatives(const sigma_matrix& sigma, const AnalysisResult& result, int block);
+
+    /**
+     * The dummy derivative levels of all blocks, in block order
+     */
+    std::vector<DummyDerivativeLevel> dummyDerivatives(const sigma_matrix& sigma, const AnalysisResult& result);
+  }
+}
+
+#endif
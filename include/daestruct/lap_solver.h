@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAESTRUCT_LAP_SOLVER_H
+#define DAESTRUCT_LAP_SOLVER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * A sparse integer linear assignment solver, which keeps its buffers between solves
+   */
+  struct daestruct_lap_solver;
+
+  /**
+   * the returned pointer must be deleted with daestruct_lap_solver_delete
+   */
+  struct daestruct_lap_solver* daestruct_lap_solver_create(void);
+
+  void daestruct_lap_solver_delete(struct daestruct_lap_solver* solver);
+
+  /**
+   * find a minimal cost perfect matching of the n x n matrix whose row i has the entries
+   * columns[row_start[i]] .. columns[row_start[i + 1] - 1] with the costs at the same positions,
+   * the costs of one row must span less than INT_MAX / 2
+   * returns 0, 1 if there is no perfect matching, or -1 for malformed input
+   */
+  int daestruct_lap_solve(struct daestruct_lap_solver* solver, int n, const int64_t* row_start,
+			  const int* columns, const int64_t* costs);
+
+  /**
+   * like daestruct_lap_solve, but warm started from a partial matching (-1 for free rows)
+   * and column duals, either of which may be NULL
+   */
+  int daestruct_lap_solve_warm(struct daestruct_lap_solver* solver, int n, const int64_t* row_start,
+			       const int* columns, const int64_t* costs,
+			       const int* row_assignment, const int* column_duals);
+
+  /**
+   * the solution of the last successful solve: the total cost, the column of every row,
+   * the row of every column and duals u, v with u[i] + v[j] <= cost(i, j), tight on the matching
+   */
+  int64_t daestruct_lap_cost(struct daestruct_lap_solver* solver);
+
+  const int* daestruct_lap_row_assignment(struct daestruct_lap_solver* solver);
+
+  const int* daestruct_lap_col_assignment(struct daestruct_lap_solver* solver);
+
+  const int64_t* daestruct_lap_row_duals(struct daestruct_lap_solver* solver);
+
+  const int* daestruct_lap_column_duals(struct daestruct_lap_solver* solver);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
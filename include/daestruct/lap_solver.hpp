@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_LAP_SOLVER_HPP
+#define DAE_LAP_SOLVER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace daestruct {
+
+  /**
+   * Sparse integer linear assignment: find a perfect matching of the rows and
+   * columns of a square cost matrix with minimal total cost, together with
+   * optimal duals (u, v), i.e. u[i] + v[j] <= cost(i, j) with equality on the
+   * matching. The solver keeps its buffers, solving problems of similar size
+   * repeatedly does not allocate.
+   *
+   * The costs are 64 bit, but the costs of one row must span less than BIG:
+   * every row is solved relative to its smallest cost, which moves the row
+   * duals only.
+   */
+  class LapSolver {
+    struct Workspace;
+    std::unique_ptr<Workspace> workspace;
+
+    std::vector<int> rowsol;
+    std::vector<int> colsol;
+    std::vector<int64_t> u;
+    std::vector<int> v;
+    int64_t total;
+
+    void load(int n, const int64_t* row_start, const int* columns, const int64_t* costs);
+
+  public:
+    LapSolver();
+    ~LapSolver();
+
+    /**
+     * solve the n x n problem whose row i has the entries columns[row_start[i]] .. columns[row_start[i + 1] - 1]
+     * (in any order) with the costs at the same positions, missing entries are forbidden.
+     * returns false if there is no perfect matching (the solution accessors are empty then),
+     * throws std::invalid_argument for malformed input
+     */
+    bool solve(int n, const int64_t* row_start, const int* columns, const int64_t* costs);
+
+    /**
+     * like solve(), but starting from the (partial) matching row_assignment (-1 for free rows)
+     * and the column duals, either of which may be null. Matched rows that are not optimal
+     * w.r.t. the given duals are freed, so any start yields an optimal solution, and a start
+     * close to the optimum only has to augment a few rows.
+     */
+    bool solve(int n, const int64_t* row_start, const int* columns, const int64_t* costs,
+	       const int* row_assignment, const int* column_duals);
+
+    /* the solution of the last successful solve */
+    int64_t cost() const { return total; }
+    const std::vector<int>& row_assignment() const { return rowsol; }
+    const std::vector<int>& col_assignment() const { return colsol; }
+    const std::vector<int64_t>& row_duals() const { return u; }
+    const std::vector<int>& column_duals() const { return v; }
+  };
+}
+
+#endif
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DAESTRUCT_PACKED_SIGMA_MATRIX_HPP
+#define DAESTRUCT_PACKED_SIGMA_MATRIX_HPP
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+
+namespace daestruct {
+
+  /**
+   * Read-only sigma matrix with compressed rows for very large models.
+   *
+   * Every row is a byte stream of its entries in column order: the distance to
+   * the previous column (the column itself for the first entry) as LEB128
+   * varint, followed by the cost as int8. On band-like models nearly every
+   * entry takes two bytes instead of the 12 of sigma_matrix. Rows are decoded
+   * on the fly by the iterators of this row matrix (see row_matrix.hpp).
+   */
+  class packed_sigma_matrix {
+    std::vector<std::size_t> row_start;
+    std::vector<uint8_t> data;
+    std::size_t entries;
+
+  public:
+    int dimension;
+
+    /**
+     * iterator over the entries of one row
+     */
+    class const_iterator2 {
+      const uint8_t* pos;
+      const uint8_t* next;
+      const uint8_t* last;
+      int row;
+      int column;
+      int value;
+
+      void decode() {
+	if (pos == last)
+	  return;
+	unsigned int delta = 0, shift = 0;
+	next = pos;
+	do {
+	  delta |= (*next & 0x7f) << shift;
+	  shift += 7;
+	} while (*next++ & 0x80);
+	column += delta;
+	value = static_cast<int8_t>(*next++);
+      }
+
+    public:
+      const_iterator2(const uint8_t* p, const uint8_t* l, int r) : pos(p), next(p), last(l), row(r), column(0), value(0) {
+	decode();
+      }
+
+      int index1() const { return row; }
+      int index2() const { return column; }
+      int operator*() const { return value; }
+
+      const_iterator2& operator++() {
+	pos = next;
+	decode();
+	return *this;
+      }
+
+      const_iterator2 operator++(int) {
+	const_iterator2 old(*this);
+	++*this;
+	return old;
+      }
+
+      bool operator==(const const_iterator2& o) const { return pos == o.pos; }
+      bool operator!=(const const_iterator2& o) const { return pos != o.pos; }
+    };
+
+    /**
+     * iterator over the rows, empty rows included
+     */
+    class const_iterator1 {
+      const packed_sigma_matrix* m;
+      int row;
+
+    public:
+      const_iterator1(const packed_sigma_matrix* matrix, int r) : m(matrix), row(r) {}
+
+      int index1() const { return row; }
+
+      const_iterator2 begin() const {
+	return const_iterator2(&m->data[0] + m->row_start[row], &m->data[0] + m->row_start[row + 1], row);
+      }
+
+      const_iterator2 end() const {
+	const uint8_t* last = &m->data[0] + m->row_start[row + 1];
+	return const_iterator2(last, last, row);
+      }
+
+      const_iterator1& operator++() {
+	row++;
+	return *this;
+      }
+
+      const_iterator1 operator++(int) {
+	const_iterator1 old(*this);
+	row++;
+	return old;
+      }
+
+      bool operator==(const const_iterator1& o) const { return row == o.row; }
+      bool operator!=(const const_iterator1& o) const { return row != o.row; }
+    };
+
+    /**
+     * true if every cost of sigma fits into the packed int8 costs
+     */
+    template<typename Matrix>
+    static bool represents(const Matrix& sigma) {
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	  if (*col_iter < std::numeric_limits<int8_t>::min() || *col_iter > std::numeric_limits<int8_t>::max())
+	    return false;
+      return true;
+    }
+
+    /**
+     * pack sigma, see represents()
+     */
+    template<typename Matrix>
+    explicit packed_sigma_matrix(const Matrix& sigma) :
+      row_start(sigma.dimension + 1, 0), entries(0), dimension(sigma.dimension) {
+      data.reserve(2 * sigma.nnz() + 1);
+
+      int next = 0;
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++) {
+	const int i = row_iter.index1();
+	/* rows without entries */
+	for (; next <= i; next++)
+	  row_start[next] = data.size();
+
+	int previous = 0;
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  const int j = col_iter.index2();
+	  unsigned int delta = j - previous;
+	  previous = j;
+	  while (delta >= 0x80) {
+	    data.push_back((delta & 0x7f) | 0x80);
+	    delta >>= 7;
+	  }
+	  data.push_back(delta);
+	  data.push_back(static_cast<uint8_t>(static_cast<int8_t>(*col_iter)));
+	  entries++;
+	}
+      }
+      for (; next <= dimension; next++)
+	row_start[next] = data.size();
+
+      /* the iterators take the address of data[0] */
+      if (data.empty())
+	data.push_back(0);
+    }
+
+    const_iterator1 rowBegin() const { return const_iterator1(this, 0); }
+
+    const_iterator1 rowEnd() const { return const_iterator1(this, dimension); }
+
+    const_iterator1 findRow(int i) const { return const_iterator1(this, i); }
+
+    std::size_t nnz() const { return entries; }
+
+    /* bytes of the packed rows */
+    std::size_t bytes() const { return data.size() + row_start.size() * sizeof(std::size_t); }
+
+    int operator()(const int i, const int j) const {
+      const const_iterator1 row = findRow(i);
+      for (auto col_iter = row.begin(); col_iter != row.end(); ++col_iter) {
+	if (col_iter.index2() == j)
+	  return *col_iter;
+	if (col_iter.index2() > j)
+	  break;
+      }
+      return BIG;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_PARTIAL_ANALYSIS_HPP
+#define DAE_PARTIAL_ANALYSIS_HPP
+
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * offsets of the equations and unknowns some query depends on
+     */
+    struct PartialResult {
+      std::vector<int> equations;
+      std::vector<int> c;
+
+      std::vector<int> variables;
+      std::vector<int> d;
+    };
+
+    /**
+     * Demand driven computation of the canonical offsets.
+     * d[j] depends on c[i] of every equation i containing j, c[i] depends on d of
+     * the unknown assigned to i. The fixpoint restricted to the closure of a query
+     * under these dependencies yields exactly the canonical offsets there.
+     * The assignment (e.g. from InputProblem::assign() or a cached result) is reused
+     * for all queries, the column index is built once.
+     */
+    class PartialAnalysis {
+      const sigma_matrix& sigma;
+      std::vector<int> assignment;
+
+      /* sigma of every equation at its assigned unknown */
+      std::vector<int> assignedCost;
+
+      /* compressed column storage of sigma */
+      std::vector<int> colStart;
+      std::vector<int> colRows;
+      std::vector<int> colValues;
+
+    public:
+      PartialAnalysis(const sigma_matrix& sigma, const std::vector<int>& row_assignment);
+
+      /**
+       * the offsets of the given equations and unknowns and of everything they depend on,
+       * throws std::invalid_argument if an index is outside the dimension
+       */
+      PartialResult query(const std::vector<int>& equations, const std::vector<int>& variables) const;
+    };
+  }
+}
+
+#endif
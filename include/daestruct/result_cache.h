@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAESTRUCT_RESULT_CACHE_H
+#define DAESTRUCT_RESULT_CACHE_H
+
+#include <daestruct.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * An on-disk cache of analysis results, shareable between processes
+   */
+  struct daestruct_cache;
+
+  /**
+   * open (or create) the cache in @directory, evicting old records when it exceeds @max_bytes (0 = unbounded)
+   * the returned pointer must be deleted with daestruct_cache_delete
+   */
+  struct daestruct_cache* daestruct_cache_create(const char* directory, unsigned long long max_bytes);
+
+  void daestruct_cache_delete(struct daestruct_cache* cache);
+
+  /**
+   * like daestruct_analyse, but returns the cached result if the structure of @problem is unchanged
+   */
+  struct daestruct_result* daestruct_analyse_cached(struct daestruct_input* problem, struct daestruct_cache* cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_RESULT_CACHE_HPP
+#define DAE_RESULT_CACHE_HPP
+
+#include <cstdint>
+#include <string>
+
+#include <daestruct/sigma_matrix.hpp>
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * canonical 128 bit hash of a sigma matrix (dimension and row-major sorted nonzeros)
+     */
+    struct SigmaHash {
+      uint64_t h1;
+      uint64_t h2;
+
+      SigmaHash(const sigma_matrix& sigma);
+
+      std::string str() const;
+
+      bool operator==(const SigmaHash& o) const { return h1 == o.h1 && h2 == o.h2; }
+    };
+
+    /**
+     * An on-disk cache of analysis results, keyed by the hash of sigma.
+     * Every result is stored in its own file, new records are written to a
+     * temporary file and renamed into place, so concurrent processes may share
+     * one cache directory. If the directory grows beyond max_bytes, the least
+     * recently used records are evicted.
+     */
+    class ResultCache {
+      std::string directory;
+      uint64_t max_bytes;
+
+      std::string path(const SigmaHash& key) const;
+
+      bool lookup(const SigmaHash& key, const sigma_matrix& sigma, AnalysisResult& result) const;
+
+      void store(const SigmaHash& key, const sigma_matrix& sigma, const AnalysisResult& result) const;
+
+      void evict() const;
+
+    public:
+      ResultCache(const std::string& dir, uint64_t max_bytes);
+
+      /**
+       * look up the result of sigma, returns false if there is no (valid) record
+       */
+      bool lookup(const sigma_matrix& sigma, AnalysisResult& result) const;
+
+      void store(const sigma_matrix& sigma, const AnalysisResult& result) const;
+
+      /**
+       * analyse the given problem, unless its result is already cached
+       */
+      AnalysisResult analyse(const InputProblem& problem) const;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DAESTRUCT_ROW_MATRIX_HPP
+#define DAESTRUCT_ROW_MATRIX_HPP
+
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+
+namespace daestruct {
+
+  /*
+   * lap(), delta_lap() and solveByFixedPoint() only iterate rows, any "row
+   * matrix" m with
+   *
+   *   m.dimension            the number of rows and columns
+   *   m.rowBegin(), rowEnd() iterators r over the rows, with r.index1(), begin() and end(), ++r, r != s
+   *   m.findRow(i)           the iterator of row i (possibly empty)
+   *   e.index2(), *e         column and cost of an entry e of a row, ++e, e != f
+   *
+   * will do. sigma_matrix, packed_sigma_matrix and csr_matrix are row
+   * matrices, callback_matrix wraps the rows of a model in the caller's
+   * own representation.
+   */
+
+  /**
+   * the cost of entry (i, j) of a row matrix, BIG if there is none
+   */
+  template<typename Matrix>
+  inline int rowCost(const Matrix& m, int i, int j) {
+    const auto row = m.findRow(i);
+    for (auto col_iter = row.begin(); col_iter != row.end(); ++col_iter)
+      if (col_iter.index2() == j)
+	return *col_iter;
+    return BIG;
+  }
+
+  /* the compressed storage finds an entry by bisection */
+  template<typename Value, typename Index>
+  inline int rowCost(const basic_sigma_matrix<Value, Index>& m, int i, int j) {
+    return m(i, j);
+  }
+
+  /**
+   * the smallest cost of every column and a row attaining it (BIG and row 0 for an empty column)
+   */
+  template<typename Matrix>
+  inline void columnMinima(const Matrix& m, std::vector<int>& minimum, std::vector<int>& minimum_row) {
+    minimum.assign(m.dimension, BIG);
+    minimum_row.assign(m.dimension, 0);
+    for (auto row_iter = m.rowBegin(); row_iter != m.rowEnd(); ++row_iter)
+      for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); ++col_iter)
+	if (*col_iter < minimum[col_iter.index2()]) {
+	  minimum[col_iter.index2()] = *col_iter;
+	  minimum_row[col_iter.index2()] = row_iter.index1();
+	}
+  }
+
+  /* sigma_matrix keeps track of its column minima on insertion */
+  template<typename Value, typename Index>
+  inline void columnMinima(const basic_sigma_matrix<Value, Index>& m, std::vector<int>& minimum, std::vector<int>& minimum_row) {
+    minimum.resize(m.dimension);
+    minimum_row.resize(m.dimension);
+    for (int j = 0; j < m.dimension; j++) {
+      minimum_row[j] = m.smallest_cost_row(j);
+      minimum[j] = m(minimum_row[j], j);
+    }
+  }
+
+  /**
+   * hands out the @return entries of @row as *columns and *values, the arrays have to
+   * stay valid as long as the matrix is in use
+   */
+  typedef int (*row_callback)(void* data, int row, const int** columns, const int** values);
+
+  /**
+   * Row matrix of rows handed out by a callback. The entries are read in place,
+   * with the costs being the values or, for a callback of derivatives, their negation.
+   */
+  class callback_matrix {
+    row_callback callback;
+    void* data;
+    int sign;
+
+  public:
+    int dimension;
+
+    /**
+     * iterator over the entries of one row
+     */
+    class const_iterator2 {
+      const int* column;
+      const int* value;
+      int sign;
+
+    public:
+      const_iterator2(const int* c, const int* v, int s) : column(c), value(v), sign(s) {}
+
+      int index2() const { return *column; }
+      int operator*() const { return sign * *value; }
+
+      const_iterator2& operator++() {
+	column++;
+	value++;
+	return *this;
+      }
+
+      const_iterator2 operator++(int) {
+	const_iterator2 old(*this);
+	++*this;
+	return old;
+      }
+
+      bool operator==(const const_iterator2& o) const { return column == o.column; }
+      bool operator!=(const const_iterator2& o) const { return column != o.column; }
+    };
+
+    /**
+     * iterator over the rows, the callback is asked once per row (end() is evaluated in every loop step)
+     */
+    class const_iterator1 {
+      const callback_matrix* m;
+      int row;
+      mutable int fetched;
+      mutable const int* columns;
+      mutable const int* values;
+      mutable int length;
+
+      void fetch() const {
+	if (fetched == row)
+	  return;
+	length = m->callback(m->data, row, &columns, &values);
+	fetched = row;
+      }
+
+    public:
+      const_iterator1(const callback_matrix* matrix, int r) :
+	m(matrix), row(r), fetched(-1), columns(nullptr), values(nullptr), length(0) {}
+
+      int index1() const { return row; }
+
+      const_iterator2 begin() const {
+	fetch();
+	return const_iterator2(columns, values, m->sign);
+      }
+
+      const_iterator2 end() const {
+	fetch();
+	return const_iterator2(columns + length, values + length, m->sign);
+      }
+
+      const_iterator1& operator++() {
+	row++;
+	return *this;
+      }
+
+      const_iterator1 operator++(int) {
+	const_iterator1 old(*this);
+	row++;
+	return old;
+      }
+
+      bool operator==(const const_iterator1& o) const { return row == o.row; }
+      bool operator!=(const const_iterator1& o) const { return row != o.row; }
+    };
+
+    callback_matrix(int n, row_callback rows, void* d, bool derivatives = false) :
+      callback(rows), data(d), sign(derivatives ? -1 : 1), dimension(n) {}
+
+    const_iterator1 rowBegin() const { return const_iterator1(this, 0); }
+
+    const_iterator1 rowEnd() const { return const_iterator1(this, dimension); }
+
+    const_iterator1 findRow(int i) const { return const_iterator1(this, i); }
+  };
+}
+
+#endif
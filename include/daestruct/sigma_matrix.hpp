@@ -23,6 +23,9 @@
 
 #include <iostream>
 #include <climits>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
 #include <boost/numeric/ublas/io.hpp>
 #include <boost/numeric/ublas/matrix_sparse.hpp>
 
@@ -31,47 +34,114 @@
 namespace daestruct {
   using namespace boost::numeric::ublas;
     
-  class sigma_matrix {
+  /**
+   * Sparse cost matrix (cost = -derivative) of a structural analysis problem.
+   * Value and Index are the types of the stored costs and of the compressed
+   * index arrays. insert() rejects costs outside of Value's range; reads
+   * always yield int, with BIG for structural zeros.
+   */
+  template<typename Value, typename Index>
+  class basic_sigma_matrix {
+  public:
+    typedef Value value_type;
+    typedef Index index_type;
+    typedef compressed_matrix<Value, row_major, 0, unbounded_array<Index>, unbounded_array<Value> > storage_type;
+    typedef typename storage_type::const_iterator1 const_iterator1;
 
-    compressed_matrix<int> m;
+  private:
+    storage_type m;
     std::vector<int> minimum_row;
-    std::vector<compressed_matrix<int>::const_iterator1> rows;
+    std::vector<const_iterator1> rows;
+
+    void findRows() {
+      rows.clear();
+      rows.reserve(dimension);
+      for (int r = 0; r < dimension; r++)
+	rows.push_back(m.find1(0, r, 0));
+    }
 
   public:
     int dimension;
 
-    sigma_matrix(int d) : m(d, d, 3*d), minimum_row(d), dimension(d) {
-      rows.reserve(d);
-      for (int r = 0; r < d; r++)
-	rows.push_back(m.find1(0, r, 0));
+    basic_sigma_matrix(int d) : m(d, d, 3*d), minimum_row(d), dimension(d) {
+      findRows();
+    }
+
+    /* the row iterators refer to m, a copy needs its own */
+    basic_sigma_matrix(const basic_sigma_matrix& o) : m(o.m), minimum_row(o.minimum_row), dimension(o.dimension) {
+      findRows();
+    }
+
+    basic_sigma_matrix& operator=(const basic_sigma_matrix& o) {
+      m = o.m;
+      minimum_row = o.minimum_row;
+      dimension = o.dimension;
+      findRows();
+      return *this;
     }
 
-    compressed_matrix<int>::const_iterator1 rowBegin() const {
+    const_iterator1 rowBegin() const {
       return m.begin1();
     }
 
-    compressed_matrix<int>::const_iterator1 rowEnd() const {
+    const_iterator1 rowEnd() const {
       return m.end1();
     }
 
-    compressed_matrix<int>::const_iterator1 findRow(int i) const {
+    const_iterator1 findRow(int i) const {
       return rows[i];
     }
 
+    /**
+     * true if every cost of sigma fits into Value and its dimension into Index
+     */
+    template<typename Matrix>
+    static bool represents(const Matrix& sigma) {
+      if (static_cast<unsigned long long>(sigma.dimension) > std::numeric_limits<Index>::max())
+	return false;
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	  if (*col_iter < std::numeric_limits<Value>::min() || *col_iter > std::numeric_limits<Value>::max())
+	    return false;
+      return true;
+    }
+
+    /**
+     * sigma in this representation, see represents()
+     */
+    template<typename Matrix>
+    static basic_sigma_matrix copy(const Matrix& sigma) {
+      basic_sigma_matrix result(sigma.dimension);
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	  result.insert(col_iter.index1(), col_iter.index2(), *col_iter);
+      return result;
+    }
+
+    std::size_t nnz() const {
+      return m.nnz();
+    }
+
     int smallest_cost_row(int column) const {
       return minimum_row[column];
     }    
 
     const int operator()(const int i, const int j) const {
-      const int* ptr = m.find_element(i,j);
+      const Value* ptr = m.find_element(i,j);
       if (ptr)
 	return *ptr;
       else
 	return BIG;
     }
 
+    /**
+     * set the cost of entry (i, j), throws std::invalid_argument if x does not fit into Value
+     */
     void insert(int i, int j, int x) {
-      const int* ptr = m.find_element(minimum_row[j],j);
+      if (x < std::numeric_limits<Value>::min() || x > std::numeric_limits<Value>::max())
+	throw std::invalid_argument("cost out of range of the sigma matrix value type");
+
+      const Value* ptr = m.find_element(minimum_row[j],j);
       
       if (!ptr || *ptr > x)
 	minimum_row[j] = i;
@@ -87,7 +157,7 @@ namespace daestruct {
     }
 
     template<class E, class T> friend std::basic_ostream<E, T> &operator << (std::basic_ostream<E, T> &os,
-									     const sigma_matrix& sigma) {
+									     const basic_sigma_matrix& sigma) {
       const long d = sigma.dimension;
     
       std::basic_ostringstream<E, T, std::allocator<E> > s;
@@ -117,6 +187,11 @@ namespace daestruct {
       return os << "sigma_matrix " << s.str ().c_str ();
     }
   };
+
+  typedef basic_sigma_matrix<int, std::size_t> sigma_matrix;
+
+  /* 5 instead of 12 bytes per nonzero, for derivatives up to 127 and dimensions below 2^32 */
+  typedef basic_sigma_matrix<int8_t, uint32_t> compact_sigma_matrix;
 }
 
 #endif 
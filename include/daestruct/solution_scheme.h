@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAESTRUCT_SOLUTION_SCHEME_H
+#define DAESTRUCT_SOLUTION_SCHEME_H
+
+#include <daestruct.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * Pryce's solution scheme: at stage k = first .. 0, every equation i with c_i + k >= 0
+   * is differentiated c_i + k times and solved for the derivatives d_j + k of the
+   * unknowns j with d_j + k >= 0
+   */
+  struct daestruct_scheme;
+
+  /**
+   * compute the solution scheme of an analysis result
+   * the returned pointer must be deleted with daestruct_scheme_delete
+   */
+  struct daestruct_scheme* daestruct_scheme_create(struct daestruct_result* result);
+
+  void daestruct_scheme_delete(struct daestruct_scheme* scheme);
+
+  /**
+   * the first stage (-max d), the last stage is 0
+   */
+  int daestruct_scheme_first_stage(struct daestruct_scheme* scheme);
+
+  /**
+   * the equations active at @stage, returns their number
+   * @equations is set to an array owned by the scheme,
+   * outside the stages it is set to NULL and 0 is returned
+   */
+  int daestruct_scheme_equations(struct daestruct_scheme* scheme, int stage, const int** equations);
+
+  /**
+   * the variables active at @stage, returns their number
+   * @variables is set to an array owned by the scheme,
+   * outside the stages it is set to NULL and 0 is returned
+   */
+  int daestruct_scheme_variables(struct daestruct_scheme* scheme, int stage, const int** variables);
+
+  /**
+   * the degrees of freedom (sum of d - sum of c)
+   */
+  long daestruct_scheme_dof(struct daestruct_scheme* scheme);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_SOLUTION_SCHEME_HPP
+#define DAE_SOLUTION_SCHEME_HPP
+
+#include <vector>
+
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * Pryce's solution scheme: at stage k = first_stage .. 0, the equations f_i^(c_i + k)
+     * with c_i + k >= 0 are solved for the unknowns x_j^(d_j + k) with d_j + k >= 0.
+     * The active sets only grow with k, so equations (variables) are stored ordered by
+     * decreasing c (d) and stage k uses a prefix of them.
+     */
+    struct SolutionScheme {
+      /* -max(d) */
+      int first_stage;
+
+      /* equations by decreasing c, equation_count[k - first_stage] of them are active at stage k */
+      std::vector<int> equations;
+      std::vector<int> equation_count;
+
+      /* variables by decreasing d, variable_count[k - first_stage] of them are active at stage k */
+      std::vector<int> variables;
+      std::vector<int> variable_count;
+
+      /* degrees of freedom, sum(d) - sum(c) */
+      long dof;
+
+      int stages() const { return equation_count.size(); }
+    };
+
+    /**
+     * bucket the equations and variables of an analysis result into stages, O(n + max(d))
+     */
+    SolutionScheme solutionScheme(const AnalysisResult& result);
+  }
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_STATIC_ANALYSIS_HPP
+#define DAE_STATIC_ANALYSIS_HPP
+
+#if __cplusplus < 201703L
+#error "daestruct/static_analysis.hpp needs C++17 (constexpr std::array element access)"
+#endif
+
+#include <array>
+#include <cstddef>
+
+/*
+ * Header only structural analysis of models whose incidence is known at
+ * compile time. The derivatives are a fixed size std::array (negative for
+ * variables not in an equation, like daestruct_analyse_dense), everything is
+ * constexpr, so c and d of a generated model can be computed by the compiler:
+ *
+ *   constexpr auto pendulum = daestruct::analysis::staticAnalysis<3>({{ {{0, 0, -1}}, {{2, -1, 0}}, {{-1, 2, 0}} }});
+ *   static_assert(pendulum.c[0] == 2, "index 3 pendulum");
+ */
+
+namespace daestruct {
+  namespace analysis {
+
+    template<std::size_t N>
+    using StaticDerivatives = std::array<std::array<int, N>, N>;
+
+    template<std::size_t N>
+    struct StaticResult {
+      /* false if the model is structurally singular, nothing else is valid then */
+      bool regular;
+
+      /* equation i is assigned to variable row_assignment[i] */
+      std::array<int, N> row_assignment;
+
+      std::array<int, N> c;
+      std::array<int, N> d;
+    };
+
+    /**
+     * Assignment of maximal total derivative (Hungarian method with shortest
+     * augmenting paths), returns false if there is none
+     */
+    template<std::size_t N>
+    constexpr bool staticAssignment(const StaticDerivatives<N>& sigma, std::array<int, N>& rowsol) {
+      /* in cost terms (cost = -derivative), columns are 1 .. N, column 0 is the row to be inserted */
+      std::array<int, N + 1> u{}, v{}, match{}, way{}, minv{};
+      std::array<bool, N + 1> used{}, reached{};
+
+      for (std::size_t i = 1; i <= N; i++) {
+	match[0] = i;
+	std::size_t j0 = 0;
+	for (std::size_t j = 0; j <= N; j++)
+	  used[j] = reached[j] = false;
+
+	do {
+	  used[j0] = true;
+	  const int row = match[j0];
+	  bool found = false;
+	  int delta = 0;
+	  std::size_t j1 = 0;
+	  for (std::size_t j = 1; j <= N; j++) {
+	    if (used[j])
+	      continue;
+	    const int derivative = sigma[row - 1][j - 1];
+	    if (derivative >= 0) {
+	      const int h = -derivative - u[row] - v[j];
+	      if (!reached[j] || h < minv[j]) {
+		minv[j] = h;
+		way[j] = j0;
+		reached[j] = true;
+	      }
+	    }
+	    if (reached[j] && (!found || minv[j] < delta)) {
+	      delta = minv[j];
+	      j1 = j;
+	      found = true;
+	    }
+	  }
+	  if (!found)
+	    return false;
+
+	  for (std::size_t j = 0; j <= N; j++)
+	    if (used[j]) {
+	      u[match[j]] += delta;
+	      v[j] -= delta;
+	    } else if (reached[j])
+	      minv[j] -= delta;
+	  j0 = j1;
+	} while (match[j0] != 0);
+
+	do {
+	  const std::size_t j1 = way[j0];
+	  match[j0] = match[j1];
+	  j0 = j1;
+	} while (j0 != 0);
+      }
+
+      for (std::size_t j = 1; j <= N; j++)
+	rowsol[match[j] - 1] = j - 1;
+      return true;
+    }
+
+    /**
+     * Pryce's fixpoint for the smallest offsets of an optimal assignment
+     */
+    template<std::size_t N>
+    constexpr void staticOffsets(const StaticDerivatives<N>& sigma, const std::array<int, N>& rowsol,
+				 std::array<int, N>& c, std::array<int, N>& d) {
+      for (std::size_t k = 0; k < N; k++)
+	c[k] = d[k] = 0;
+
+      bool converged = false;
+      while (!converged) {
+	converged = true;
+
+	for (std::size_t i = 0; i < N; i++)
+	  for (std::size_t j = 0; j < N; j++)
+	    if (sigma[i][j] >= 0 && sigma[i][j] + c[i] > d[j])
+	      d[j] = sigma[i][j] + c[i];
+
+	for (std::size_t i = 0; i < N; i++) {
+	  const int c2 = d[rowsol[i]] - sigma[i][rowsol[i]];
+	  if (c[i] != c2)
+	    converged = false;
+	  c[i] = c2;
+	}
+      }
+    }
+
+    template<std::size_t N>
+    constexpr StaticResult<N> staticAnalysis(const StaticDerivatives<N>& sigma) {
+      StaticResult<N> result{};
+      result.regular = staticAssignment(sigma, result.row_assignment);
+      if (result.regular)
+	staticOffsets(sigma, result.row_assignment, result.c, result.d);
+      return result;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_TEARING_HPP
+#define DAE_TEARING_HPP
+
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * Tearing of the BLT blocks of an analysis result, all blocks concatenated.
+     * Block b owns tears[tear_start[b] .. tear_start[b+1] - 1] (same for residuals)
+     * and the causal sequence equations/variables[order_start[b] .. order_start[b+1] - 1]:
+     * guessing the tear variables, equations[k] is solved for variables[k] in this order,
+     * the residual equations remain to be satisfied by the iteration.
+     */
+    struct Tearing {
+      std::vector<int> tear_start;
+      std::vector<int> tears;
+      std::vector<int> residuals;
+
+      std::vector<int> order_start;
+      std::vector<int> equations;
+      std::vector<int> variables;
+
+      int blocks() const { return tear_start.empty() ? 0 : tear_start.size() - 1; }
+    };
+
+    /**
+     * Cellier's greedy heuristic on the system Jacobian within every BLT block:
+     * solve equations with a single unknown left, otherwise tear the unknown that
+     * occurs in most of the unsolved equations. Needs result.blt.
+     */
+    Tearing tearing(const sigma_matrix& sigma, const AnalysisResult& result);
+  }
+}
+
+#endif
@@ -22,6 +22,8 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <memory>
+#include <iostream>
 
 #include <boost/icl/interval.hpp>
 #include <boost/icl/interval_map.hpp>
@@ -43,9 +45,29 @@ namespace daestruct {
       std::vector<NewRow> newRows;
     };
 
+    struct ChangedProblem;
+
+    /**
+     * Write a snapshot of an incremental analysis session, i.e. the current problem and its last result.
+     * A session can be started from the original problem, too.
+     */
+    void saveSession(std::ostream& o, const ChangedProblem& problem, const AnalysisResult& result);
+
+    void saveSession(std::ostream& o, const InputProblem& problem, const AnalysisResult& result);
+
+    /**
+     * Restore a session snapshot, returns an empty pointer if the stream does not contain a valid snapshot
+     */
+    std::unique_ptr<ChangedProblem> restoreSession(std::istream& i, AnalysisResult& result);
+
     struct ChangedProblem {
     private:
       void applyDiff(const sigma_matrix& oldSigma, const AnalysisResult& result, const StructChange& delta);
+
+      /* empty problem, to be filled by restoreSession */
+      ChangedProblem(int d) : dimension(d), sigma(d) {}
+
+      friend std::unique_ptr<ChangedProblem> restoreSession(std::istream& i, AnalysisResult& result);
     public:
       int old_columns;
       int old_rows;
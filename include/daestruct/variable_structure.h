@@ -69,8 +69,28 @@ extern "C" {
 
   void daestruct_changed_delete(struct daestruct_changed* changed);
 
+  /**
+   * analyse the changed problem, returns NULL if it is structurally singular
+   */
   struct daestruct_result* daestruct_changed_analyse(struct daestruct_changed* problem);
 
+  /**
+   * save the incremental session (problem and its last analysis result) to @file
+   * returns 0 on success
+   */
+  int daestruct_session_save(const char* file, struct daestruct_changed* problem, struct daestruct_result* result);
+
+  /**
+   * save a session that starts at the original problem
+   */
+  int daestruct_session_save_orig(const char* file, struct daestruct_input* problem, struct daestruct_result* result);
+
+  /**
+   * restore a session from @file, the last analysis result is stored in @result
+   * returns NULL if @file does not contain a valid session
+   */
+  struct daestruct_changed* daestruct_session_restore(const char* file, struct daestruct_result** result);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,28 +23,116 @@
 #include <iostream>
 #include <vector>
 #include <climits>
+#include <cstdint>
+#include <memory>
 
 #include <daestruct/sigma_matrix.hpp>
+#include <daestruct/packed_sigma_matrix.hpp>
+#include <daestruct/csr_matrix.hpp>
+#include <daestruct/row_matrix.hpp>
 
 struct solution {
-  int cost;
+  /* the sum of n costs can exceed int */
+  int64_t cost;
   std::vector<int> rowsol;
   std::vector<int> colsol;
   std::vector<int> u;
   std::vector<int> v;  
 };
 
+struct augmentation_data;
+
 /**
- * Solve the integer linear assignment problem defined by the cost matrix
+ * The buffers of lap() and delta_lap(). Solving with the same workspace again
+ * only allocates if the dimension grows.
  */
-solution lap(const daestruct::sigma_matrix& cost);
+struct lap_workspace {
+  std::vector<int> free;
+  std::vector<int> matches;
+  std::vector<int> minimum_row;
+  std::vector<bool> constrained;
+  std::unique_ptr<augmentation_data> data;
+
+  lap_workspace();
+  ~lap_workspace();
+
+  /* make room for problems up to dimension dim */
+  void reserve(int dim);
+};
+
+/**
+ * Solve the integer linear assignment problem defined by the cost matrix, a row
+ * matrix (see row_matrix.hpp) with an entry in every row and column. Instantiated
+ * for sigma_matrix, compact_sigma_matrix, packed_sigma_matrix, csr_matrix and callback_matrix
+ */
+template<typename Matrix>
+solution lap(const Matrix& cost);
+
+/**
+ * like lap(), but with the given buffers, the vectors of result are reused as well
+ */
+template<typename Matrix>
+void lap(const Matrix& cost, lap_workspace& workspace, solution& result);
 
 /**
  * Solve the integer linear assignment problem using an older (partiall) assignment
  */
-solution delta_lap(const daestruct::sigma_matrix& assigncost, const std::vector<int>& _u, const std::vector<int>& _v, 
+template<typename Matrix>
+solution delta_lap(const Matrix& assigncost, const std::vector<int>& _u, const std::vector<int>& _v, 
 		   const std::vector<int>& _rowsol, const std::vector<int>& _colsol);
 
+/**
+ * like delta_lap(), but with the given buffers, result must not alias the old assignment
+ */
+template<typename Matrix>
+void delta_lap(const Matrix& assigncost, const std::vector<int>& _u, const std::vector<int>& _v,
+	       const std::vector<int>& _rowsol, const std::vector<int>& _colsol,
+	       lap_workspace& workspace, solution& result);
+
+/**
+ * Solve the assignment problem of a dense row major n x n cost matrix (BIG for
+ * structural zeros) by shortest augmenting paths over the contiguous rows.
+ * For nearly dense problems the sparse iteration of lap() is pure overhead.
+ */
+solution dense_lap(int n, const std::vector<int>& cost);
+
+/* the density (nnz / n²) from which on dense_lap() beats lap() */
+const double dense_lap_density = 0.25;
+
+extern template solution lap(const daestruct::sigma_matrix&);
+extern template solution lap(const daestruct::compact_sigma_matrix&);
+extern template solution lap(const daestruct::packed_sigma_matrix&);
+extern template solution lap(const daestruct::csr_matrix&);
+extern template solution lap(const daestruct::callback_matrix&);
+
+extern template void lap(const daestruct::sigma_matrix&, lap_workspace&, solution&);
+extern template void lap(const daestruct::compact_sigma_matrix&, lap_workspace&, solution&);
+extern template void lap(const daestruct::packed_sigma_matrix&, lap_workspace&, solution&);
+extern template void lap(const daestruct::csr_matrix&, lap_workspace&, solution&);
+extern template void lap(const daestruct::callback_matrix&, lap_workspace&, solution&);
+
+extern template solution delta_lap(const daestruct::sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+				   const std::vector<int>&, const std::vector<int>&);
+extern template solution delta_lap(const daestruct::compact_sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+				   const std::vector<int>&, const std::vector<int>&);
+extern template solution delta_lap(const daestruct::packed_sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+				   const std::vector<int>&, const std::vector<int>&);
+extern template solution delta_lap(const daestruct::csr_matrix&, const std::vector<int>&, const std::vector<int>&,
+				   const std::vector<int>&, const std::vector<int>&);
+extern template solution delta_lap(const daestruct::callback_matrix&, const std::vector<int>&, const std::vector<int>&,
+				   const std::vector<int>&, const std::vector<int>&);
+
+extern template void delta_lap(const daestruct::sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+			       const std::vector<int>&, const std::vector<int>&, lap_workspace&, solution&);
+extern template void delta_lap(const daestruct::compact_sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+			       const std::vector<int>&, const std::vector<int>&, lap_workspace&, solution&);
+extern template void delta_lap(const daestruct::packed_sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+			       const std::vector<int>&, const std::vector<int>&, lap_workspace&, solution&);
+extern template void delta_lap(const daestruct::csr_matrix&, const std::vector<int>&, const std::vector<int>&,
+			       const std::vector<int>&, const std::vector<int>&, lap_workspace&, solution&);
+extern template void delta_lap(const daestruct::callback_matrix&, const std::vector<int>&, const std::vector<int>&,
+			       const std::vector<int>&, const std::vector<int>&, lap_workspace&, solution&);
+
 std::ostream& operator<<(std::ostream& o, const solution& s);
 
 #endif
@@ -20,17 +20,32 @@
 #include <daestruct/analysis.hpp>
 
 #include <vector>
+#include <algorithm>
+#include <climits>
 
 #include "lap.hpp"
+#include "dense_assignment.hpp"
+#include "elimination.hpp"
+#include "matching.hpp"
+#include "reordering.hpp"
+#include "symmetry.hpp"
 #include "prettyprint.hpp"
 #include <iostream>
 
 namespace daestruct {
   namespace analysis {
   
+    template<typename Matrix>
     void solveByFixedPoint(const std::vector<int>& assignment,  
-			   const sigma_matrix& sigma,
+			   const Matrix& sigma,
 			   std::vector<int>& c, std::vector<int>& d) {
+      solveByFixedPoint(assignment, sigma, c, d, -1);
+    }
+
+    template<typename Matrix>
+    int solveByFixedPoint(const std::vector<int>& assignment,
+			  const Matrix& sigma,
+			  std::vector<int>& c, std::vector<int>& d, int max_offset) {
       bool converged = false;
 
       while (!converged) {
@@ -49,9 +64,9 @@ namespace daestruct {
 	  }
 	}
 
-	for (unsigned int i = 0; i < sigma.dimension; i++) {
+	for (int i = 0; i < sigma.dimension; i++) {
 	  const int j = assignment[i];
-	  const int c2 = d[j] + sigma(i, j);
+	  const int c2 = d[j] + rowCost(sigma, i, j);
 	  
 	  if (c[i] != c2) {
 	    converged = false;
@@ -60,6 +75,8 @@ namespace daestruct {
 	  //std::cout << "c[" << i << "] = " << c2 << "(because d[" << j << "] = " << d[j] << ")" << std::endl;
 
 	  c[i] = c2;
+	  if (max_offset >= 0 && c2 > max_offset)
+	    return i;
 	  /*
 	  for (unsigned int j = 0; j < sigma.dimension; j++)
 	    if (d[j] < c[i] - sigma(i,j))
@@ -67,18 +84,132 @@ namespace daestruct {
 	  */
 	}
       }
+      return -1;
+    }
+
+    template void solveByFixedPoint(const std::vector<int>&, const sigma_matrix&, std::vector<int>&, std::vector<int>&);
+    template void solveByFixedPoint(const std::vector<int>&, const compact_sigma_matrix&, std::vector<int>&, std::vector<int>&);
+    template int solveByFixedPoint(const std::vector<int>&, const sigma_matrix&, std::vector<int>&, std::vector<int>&, int);
+    template int solveByFixedPoint(const std::vector<int>&, const compact_sigma_matrix&, std::vector<int>&, std::vector<int>&, int);
+    template void solveByFixedPoint(const std::vector<int>&, const packed_sigma_matrix&, std::vector<int>&, std::vector<int>&);
+    template int solveByFixedPoint(const std::vector<int>&, const packed_sigma_matrix&, std::vector<int>&, std::vector<int>&, int);
+    template void solveByFixedPoint(const std::vector<int>&, const csr_matrix&, std::vector<int>&, std::vector<int>&);
+    template int solveByFixedPoint(const std::vector<int>&, const csr_matrix&, std::vector<int>&, std::vector<int>&, int);
+    template void solveByFixedPoint(const std::vector<int>&, const callback_matrix&, std::vector<int>&, std::vector<int>&);
+    template int solveByFixedPoint(const std::vector<int>&, const callback_matrix&, std::vector<int>&, std::vector<int>&, int);
+
+    /**
+     * Index 0/1 check: if every equation can be assigned to a variable it contains
+     * in the highest derivative of that variable, then c = 0, d = column maxima
+     * is a feasible dual with the same value as this assignment, hence optimal.
+     * It is also the smallest one, since c >= 0.
+     */
+    static bool highestDerivativeMatching(const sigma_matrix& sigma, AnalysisResult& result) {
+      const int n = sigma.dimension;
+      std::vector<int> d(n, INT_MIN);
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	  d[col_iter.index2()] = std::max(d[col_iter.index2()], -*col_iter);
+
+      const BipartiteGraph tight = incidence(sigma, [&d](int, int j, int value) { return -value == d[j]; });
+
+      std::vector<int> rowsol, colsol;
+      if (maximumMatching(tight, rowsol, colsol) < n)
+	return false;
+
+      result.row_assignment = std::move(rowsol);
+      result.col_assignment = std::move(colsol);
+      result.c.assign(n, 0);
+      result.d = std::move(d);
+      return true;
+    }
+
+    /**
+     * lap() or, for a nearly dense problem, dense_lap() on its row major costs
+     */
+    static solution solveLap(const sigma_matrix& sigma, const AnalysisOptions& options) {
+      const int n = sigma.dimension;
+      if (options.dense && n > 0 && sigma.nnz() >= dense_lap_density * n * n) {
+	std::vector<int> cost(static_cast<std::size_t>(n) * n, BIG);
+	for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	    cost[col_iter.index1() * n + col_iter.index2()] = *col_iter;
+	return dense_lap(n, cost);
+      }
+      return options.reorder ? reorderedLap(sigma) : lap(sigma);
+    }
+
+    AnalysisResult InputProblem::assign() const {
+      AnalysisResult result;
+
+      if (options.fast_path && highestDerivativeMatching(sigma, result)) {
+	result.stats.fast_path = true;
+	return result;
+      }
+
+      /* a singular problem is left to the decomposition below */
+      if (options.dense && dimension <= dense_max_dimension) {
+	const DenseSigma dense(sigma);
+	std::vector<int> rowsol(dimension);
+	if (denseAssignment(dense, rowsol.data())) {
+	  result.col_assignment.resize(dimension);
+	  for (int i = 0; i < dimension; i++)
+	    result.col_assignment[rowsol[i]] = i;
+	  result.row_assignment = std::move(rowsol);
+	  result.stats.dense = true;
+	  return result;
+	}
+      }
+
+      const DulmageMendelsohn dm = dulmageMendelsohn(sigma);
+      if (dm.rank < dimension)
+	throw StructurallySingular(dm);
+
+      bool assigned = options.symmetry && symmetricAssignment(sigma, result);
+
+      if (!assigned && options.eliminate) {
+	/* solve the reduced linear assignment problem and expand its solution */
+	Elimination elimination(sigma);
+	if (elimination.valid()) {
+	  const sigma_matrix& reduced = elimination.reduced();
+	  std::vector<int> reduced_rowsol;
+	  if (reduced.dimension > 0) {
+	    solution assignment = solveLap(reduced, options);
+	    reduced_rowsol = std::move(assignment.rowsol);
+	  }
+	  elimination.expand(reduced_rowsol, result.row_assignment, result.col_assignment);
+	  result.stats.lap_dimension = reduced.dimension;
+	  assigned = true;
+	}
+      }
+
+      if (!assigned) {
+	/* solve linear assignment problem */
+	solution assignment = solveLap(sigma, options);
+
+	std::cout << "lap solved: " << assignment.cost << std::endl;
+	result.row_assignment = std::move(assignment.rowsol);
+	result.col_assignment = std::move(assignment.colsol);
+	result.stats.lap_dimension = dimension;
+      }
+
+      return result;
     }
 
     AnalysisResult InputProblem::pryceAlgorithm() const {
       //std::cout << sigma << std::endl;
 
-      /* solve linear assignment problem */
-      solution assignment = lap(sigma);
+      AnalysisResult result = assign();
+      if (!result.stats.fast_path)
+	solveOffsets(result);
 
-      std::cout << "lap solved: " << assignment.cost << std::endl;
-      AnalysisResult result;
-      result.row_assignment = std::move(assignment.rowsol);
-      result.col_assignment = std::move(assignment.colsol);
+      if (options.blt && result.bound_witness < 0)
+	result.blt = bltDecomposition(sigma, result);
+
+      return result;
+    }
+
+    void InputProblem::solveOffsets(AnalysisResult& result) const {
       result.c.resize(dimension);
       result.d.resize(dimension);
 
@@ -97,10 +228,8 @@ namespace daestruct {
 
       /* run fix-point algorithm */
       std::cout << "Calculating smallest dual" << std::endl;
-      solveByFixedPoint(result.row_assignment, sigma, result.c, result.d);
+      result.bound_witness = solveByFixedPoint(result.row_assignment, sigma, result.c, result.d, options.max_offset);
       //std::cout << "Canonical: c=" << result.c << " d=" << result.d << std::endl;
-
-      return result;
     }
   }
 }
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis_plan.hpp>
+#include <daestruct/csr_matrix.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "lap.hpp"
+#include "matching.hpp"
+
+namespace daestruct {
+  namespace analysis {
+
+    struct AnalysisPlan::Workspace::Lap {
+      lap_workspace buffers;
+      solution assignment;
+    };
+
+    AnalysisPlan::Workspace::Workspace() : lap(new Lap()) {}
+
+    AnalysisPlan::Workspace::Workspace(const AnalysisPlan& plan) : lap(new Lap()) {
+      assignedEntry.reserve(plan.n);
+      cost.reserve(plan.nnz());
+      blockCost.reserve(plan.blockEntry.size());
+      denseCost.reserve(static_cast<std::size_t>(plan.largestDenseBlock) * plan.largestDenseBlock);
+
+      const int size = plan.largestSparseBlock;
+      lap->buffers.reserve(size);
+      lap->assignment.rowsol.reserve(size);
+      lap->assignment.colsol.reserve(size);
+      lap->assignment.u.reserve(size);
+      lap->assignment.v.reserve(size);
+    }
+
+    AnalysisPlan::Workspace::Workspace(Workspace&&) = default;
+
+    AnalysisPlan::Workspace& AnalysisPlan::Workspace::operator=(Workspace&&) = default;
+
+    AnalysisPlan::Workspace::~Workspace() {}
+
+    /* blocks of at least this density are solved by dense_lap() */
+    static bool denseBlock(int64_t entries, int size) {
+      return entries >= dense_lap_density * size * size;
+    }
+
+    AnalysisPlan::AnalysisPlan(const sigma_matrix& pattern) :
+      n(pattern.dimension), largestSparseBlock(0), largestDenseBlock(0) {
+      BipartiteGraph graph = incidence(pattern, [](int, int, int) { return true; });
+      rowStart.assign(graph.start.begin(), graph.start.end());
+      column = graph.adjacent;
+
+      std::vector<int> rowMatch, colMatch;
+      if (maximumMatching(graph, rowMatch, colMatch) < n)
+	throw StructurallySingular(dulmageMendelsohn(pattern));
+
+      const BLT blt = blockTriangular(graph, rowMatch, colMatch);
+      blockStart = blt.block_start;
+      blockRows = blt.equations;
+      blockColumns = blt.variables;
+
+      std::vector<int> rowBlock(n), localRow(n), colBlock(n), localColumn(n);
+      for (int b = 0; b < blocks(); b++)
+	for (int k = blockStart[b]; k < blockStart[b + 1]; k++) {
+	  rowBlock[blockRows[k]] = colBlock[blockColumns[k]] = b;
+	  localRow[blockRows[k]] = localColumn[blockColumns[k]] = k - blockStart[b];
+	}
+
+      std::vector<std::pair<int, int64_t>> row;
+      blockEntryStart.push_back(0);
+      for (int b = 0; b < blocks(); b++) {
+	for (int k = blockStart[b]; k < blockStart[b + 1]; k++) {
+	  const int i = blockRows[k];
+	  blockRowStart.push_back(blockEntry.size());
+	  row.clear();
+	  for (int64_t e = rowStart[i]; e < rowStart[i + 1]; e++)
+	    if (colBlock[column[e]] == b)
+	      row.push_back(std::make_pair(localColumn[column[e]], e));
+
+	  /* the rows of a block are sorted by local column */
+	  std::sort(row.begin(), row.end());
+	  for (const auto& entry : row) {
+	    blockEntryRow.push_back(localRow[i]);
+	    blockEntryColumn.push_back(entry.first);
+	    blockEntry.push_back(entry.second);
+	  }
+	}
+	blockRowStart.push_back(blockEntry.size());
+	blockEntryStart.push_back(blockEntry.size());
+
+	const int size = blockStart[b + 1] - blockStart[b];
+	if (size > 1) {
+	  int& largest = denseBlock(blockEntryStart[b + 1] - blockEntryStart[b], size) ? largestDenseBlock : largestSparseBlock;
+	  largest = std::max(largest, size);
+	}
+      }
+    }
+
+    int64_t AnalysisPlan::position(int equation, int variable) const {
+      auto first = column.begin() + rowStart[equation], last = column.begin() + rowStart[equation + 1];
+      auto it = std::lower_bound(first, last, variable);
+      return it != last && *it == variable ? it - column.begin() : -1;
+    }
+
+    std::vector<int> AnalysisPlan::values(const sigma_matrix& sigma) const {
+      if ((int)sigma.dimension != n || (int64_t)sigma.nnz() != nnz())
+	throw std::invalid_argument("sigma does not have the planned pattern");
+
+      std::vector<int> derivatives(nnz());
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  const int64_t e = position(col_iter.index1(), col_iter.index2());
+	  if (e < 0)
+	    throw std::invalid_argument("sigma does not have the planned pattern");
+	  derivatives[e] = -*col_iter;
+	}
+      return derivatives;
+    }
+
+    AnalysisResult AnalysisPlan::execute(const std::vector<int>& derivatives) const {
+      Workspace workspace(*this);
+      return execute(derivatives, workspace);
+    }
+
+    AnalysisResult AnalysisPlan::execute(const std::vector<int>& derivatives, Workspace& workspace) const {
+      if ((int64_t)derivatives.size() != nnz())
+	throw std::invalid_argument("expected one derivative per planned entry");
+
+      /* a moved-from workspace gets fresh buffers */
+      if (!workspace.lap)
+	workspace.lap.reset(new Workspace::Lap());
+
+      std::vector<int64_t>& assignedEntry = workspace.assignedEntry;
+      assignedEntry.resize(n);
+      std::vector<int>& cost = workspace.cost;
+      cost.resize(nnz());
+      for (int64_t e = 0; e < nnz(); e++)
+	cost[e] = -derivatives[e];
+      std::vector<int>& blockCost = workspace.blockCost;
+      blockCost.resize(blockEntry.size());
+
+      AnalysisResult result;
+      for (int b = 0; b < blocks(); b++) {
+	const int size = blockStart[b + 1] - blockStart[b];
+	const int64_t first = blockEntryStart[b], last = blockEntryStart[b + 1];
+
+	/* a single equation has to take the matched unknown */
+	if (size == 1) {
+	  assignedEntry[blockRows[blockStart[b]]] = blockEntry[first];
+	  continue;
+	}
+
+	solution& assignment = workspace.lap->assignment;
+	if (denseBlock(last - first, size)) {
+	  std::vector<int>& denseCost = workspace.denseCost;
+	  denseCost.assign(static_cast<std::size_t>(size) * size, BIG);
+	  for (int64_t e = first; e < last; e++)
+	    denseCost[static_cast<std::size_t>(blockEntryRow[e]) * size + blockEntryColumn[e]] = cost[blockEntry[e]];
+	  assignment = dense_lap(size, denseCost);
+	} else {
+	  for (int64_t e = first; e < last; e++)
+	    blockCost[e] = cost[blockEntry[e]];
+	  const csr_matrix local(size, &blockRowStart[blockStart[b] + b], blockEntryColumn.data(), blockCost.data());
+	  lap(local, workspace.lap->buffers, assignment);
+	}
+	for (int64_t e = first; e < last; e++)
+	  if (assignment.rowsol[blockEntryRow[e]] == blockEntryColumn[e])
+	    assignedEntry[blockRows[blockStart[b] + blockEntryRow[e]]] = blockEntry[e];
+
+	result.stats.lap_dimension = std::max<long>(result.stats.lap_dimension, size);
+      }
+
+      result.row_assignment.resize(n);
+      result.col_assignment.resize(n);
+      for (int i = 0; i < n; i++) {
+	result.row_assignment[i] = column[assignedEntry[i]];
+	result.col_assignment[column[assignedEntry[i]]] = i;
+      }
+
+      result.c.assign(n, 0);
+      result.d.assign(n, 0);
+      const csr_matrix sigma(n, rowStart.data(), column.data(), cost.data());
+      solveByFixedPoint(result.row_assignment, sigma, result.c, result.d);
+
+      return result;
+    }
+  }
+}
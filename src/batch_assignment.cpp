@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "batch_assignment.hpp"
+
+#include <climits>
+#include <cstring>
+
+namespace daestruct {
+  namespace analysis {
+
+    namespace {
+      const int W = batch_lanes;
+
+      /* one int per lane, comparisons yield -1 (true) or 0 per lane */
+      typedef int lanes __attribute__((vector_size(batch_lanes * sizeof(int))));
+
+      inline lanes broadcast(int x) {
+	lanes r;
+	for (int l = 0; l < W; l++)
+	  r[l] = x;
+	return r;
+      }
+
+      inline lanes select(lanes mask, lanes a, lanes b) { return (a & mask) | (b & ~mask); }
+
+      inline bool any(lanes mask) {
+	for (int l = 0; l < W; l++)
+	  if (mask[l])
+	    return true;
+	return false;
+      }
+
+      /* the entries of BatchSigma are not aligned to the vector size */
+      inline lanes load(const int* p) {
+	lanes r;
+	std::memcpy(&r, p, sizeof(r));
+	return r;
+      }
+    }
+
+    void BatchSigma::load(int lanes, const int* derivatives) {
+      const int n = dimension;
+      for (int l = 0; l < W; l++)
+	for (int i = 0; i < n; i++)
+	  for (int j = 0; j < n; j++) {
+	    const int der = l < lanes ? derivatives[(l * n + i) * n + j] : (i == j ? 0 : -1);
+	    entries[(i * n + j) * W + l] = der >= 0 ? -der : BIG;
+	  }
+    }
+
+    void batchAssignment(const BatchSigma& sigma, int* rowsol, int* singular) {
+      const int n = sigma.dimension;
+      const int* cost = sigma.costs();
+      const lanes big = broadcast(BIG), none = broadcast(-1), zero = broadcast(0);
+
+      /* per column: price, potential of the matched row, matched row, shortest path tree */
+      lanes v[dense_max_dimension], ucol[dense_max_dimension], match[dense_max_dimension];
+      lanes way[dense_max_dimension], minv[dense_max_dimension], used[dense_max_dimension];
+
+      for (int j = 0; j < n; j++) {
+	v[j] = ucol[j] = zero;
+	match[j] = none;
+      }
+      lanes failed = zero;
+
+      for (int i = 0; i < n; i++) {
+	for (int j = 0; j < n; j++) {
+	  minv[j] = big;
+	  used[j] = zero;
+	}
+
+	/* potential of the new row, row and potential of the tree node to relax next */
+	lanes ui = zero, urow = zero, j0 = none, row = broadcast(i);
+	lanes active = ~failed;
+
+	while (any(active)) {
+	  for (int j = 0; j < n; j++) {
+	    lanes c;
+	    for (int l = 0; l < W; l++)
+	      c[l] = cost[(row[l] * n + j) * W + l];
+	    const lanes h = c - urow - v[j];
+	    const lanes relax = active & ~used[j] & (c < big) & (h < minv[j]);
+	    minv[j] = select(relax, h, minv[j]);
+	    way[j] = select(relax, j0, way[j]);
+	  }
+
+	  lanes delta = big, j1 = none;
+	  for (int j = 0; j < n; j++) {
+	    const lanes better = active & ~used[j] & (minv[j] < delta);
+	    delta = select(better, minv[j], delta);
+	    j1 = select(better, broadcast(j), j1);
+	  }
+
+	  const lanes stuck = active & (j1 < zero);
+	  failed |= stuck;
+	  active &= ~stuck;
+
+	  const lanes step = select(active, delta, zero);
+	  ui += step;
+	  for (int j = 0; j < n; j++) {
+	    ucol[j] += used[j] & step;
+	    v[j] -= used[j] & step;
+	    minv[j] -= ~used[j] & (minv[j] < big) & step;
+	  }
+
+	  /* lanes that reached a free column are done with this row */
+	  j0 = select(active, j1, j0);
+	  for (int l = 0; l < W; l++)
+	    if (active[l]) {
+	      const int j = j1[l];
+	      used[j][l] = -1;
+	      if (match[j][l] < 0)
+		active[l] = 0;
+	      else {
+		row[l] = match[j][l];
+		urow[l] = ucol[j][l];
+	      }
+	    }
+	}
+
+	/* augment along the tree paths, the rows keep their potentials */
+	for (int l = 0; l < W; l++)
+	  if (!failed[l])
+	    for (int j = j0[l]; j >= 0; ) {
+	      const int prev = way[j][l];
+	      match[j][l] = prev >= 0 ? match[prev][l] : i;
+	      ucol[j][l] = prev >= 0 ? ucol[prev][l] : ui[l];
+	      j = prev;
+	    }
+      }
+
+      for (int l = 0; l < W; l++)
+	singular[l] = failed[l] != 0;
+      for (int j = 0; j < n; j++)
+	for (int l = 0; l < W; l++)
+	  if (!failed[l])
+	    rowsol[match[j][l] * W + l] = j;
+    }
+
+    void batchOffsets(const BatchSigma& sigma, const int* rowsol, const int* singular, int* c, int* d) {
+      const int n = sigma.dimension;
+      const int* cost = sigma.costs();
+      const lanes big = broadcast(BIG), zero = broadcast(0);
+
+      lanes valid;
+      for (int l = 0; l < W; l++)
+	valid[l] = singular[l] ? 0 : -1;
+
+      lanes lc[dense_max_dimension], ld[dense_max_dimension];
+      for (int k = 0; k < n; k++)
+	lc[k] = ld[k] = zero;
+
+      /* converged lanes stay put, so the lanes are only masked by singularity */
+      bool converged = false;
+      while (!converged) {
+	converged = true;
+
+	for (int i = 0; i < n; i++)
+	  for (int j = 0; j < n; j++) {
+	    const lanes s = load(cost + (i * n + j) * W);
+	    const lanes a = lc[i] - s;
+	    ld[j] = select((s < big) & (a > ld[j]), a, ld[j]);
+	  }
+
+	for (int i = 0; i < n; i++) {
+	  lanes assigned;
+	  for (int l = 0; l < W; l++) {
+	    const int j = valid[l] ? rowsol[i * W + l] : i;
+	    assigned[l] = ld[j][l] + cost[(i * n + j) * W + l];
+	  }
+	  const lanes c2 = select(valid, assigned, lc[i]);
+	  if (any(c2 != lc[i]))
+	    converged = false;
+	  lc[i] = c2;
+	}
+      }
+
+      for (int k = 0; k < n; k++)
+	for (int l = 0; l < W; l++) {
+	  c[k * W + l] = lc[k][l];
+	  d[k * W + l] = ld[k][l];
+	}
+    }
+  }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_BATCH_ASSIGNMENT_HPP
+#define DAE_BATCH_ASSIGNMENT_HPP
+
+#include <vector>
+
+#include "dense_assignment.hpp"
+
+namespace daestruct {
+  namespace analysis {
+
+    /* problems solved in lockstep, one per lane (the int32 width of AVX2) */
+    const int batch_lanes = 8;
+
+    /**
+     * Up to batch_lanes problems of the same dimension in structure of arrays
+     * form: entry (i, j) of all lanes is contiguous. Every step of the
+     * Hungarian method and of the fixpoint is a loop over the lanes, which
+     * the compiler vectorises; lanes that are done are masked out.
+     */
+    class BatchSigma {
+      std::vector<int> entries;
+
+    public:
+      const int dimension;
+
+      /* the buffer is reused by every load() */
+      explicit BatchSigma(int n) : entries(n * n * batch_lanes), dimension(n) {}
+
+      /**
+       * load the row major derivatives of lanes consecutive problems (see DenseSigma),
+       * unused lanes get an identity problem
+       */
+      void load(int lanes, const int* derivatives);
+
+      /* BIG for structural zeros */
+      int cost(int i, int j, int lane) const { return entries[(i * dimension + j) * batch_lanes + lane]; }
+
+      const int* costs() const { return entries.data(); }
+    };
+
+    /**
+     * Optimal assignments of all lanes, rowsol[i * batch_lanes + lane].
+     * singular[lane] is set if that problem is structurally singular.
+     */
+    void batchAssignment(const BatchSigma& sigma, int* rowsol, int* singular);
+
+    /**
+     * Smallest offsets of all nonsingular lanes, c and d are indexed like rowsol
+     */
+    void batchOffsets(const BatchSigma& sigma, const int* rowsol, const int* singular, int* c, int* d);
+  }
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_BINARY_IO_HPP
+#define DAE_BINARY_IO_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+
+/*
+ * Raw binary (de-)serialization helpers shared by the on-disk formats.
+ * All values are written in host byte order, records are not meant to be
+ * exchanged between machines of different endianness.
+ */
+namespace daestruct {
+  namespace io {
+
+    template<typename T> inline void write(std::ostream& o, const T& x) {
+      o.write(reinterpret_cast<const char*>(&x), sizeof(T));
+    }
+
+    template<typename T> inline bool read(std::istream& i, T& x) {
+      return i.read(reinterpret_cast<char*>(&x), sizeof(T)).good();
+    }
+
+    inline void writeVector(std::ostream& o, const std::vector<int>& v) {
+      write(o, static_cast<int64_t>(v.size()));
+      if (!v.empty())
+	o.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(int));
+    }
+
+    /* a size beyond max_size is rejected before anything is allocated */
+    inline bool readVector(std::istream& i, std::vector<int>& v, int64_t max_size = INT64_MAX) {
+      int64_t size;
+      if (!read(i, size) || size < 0 || size > max_size)
+	return false;
+      v.resize(size);
+      if (size == 0)
+	return true;
+      return i.read(reinterpret_cast<char*>(v.data()), size * sizeof(int)).good();
+    }
+
+    /* writes the dimension, the number of nonzeros and all (row, column, value) triples in row-major order */
+    inline void writeSigma(std::ostream& o, const sigma_matrix& sigma) {
+      write(o, static_cast<int64_t>(sigma.dimension));
+      write(o, static_cast<int64_t>(sigma.nnz()));
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  write(o, static_cast<int32_t>(col_iter.index1()));
+	  write(o, static_cast<int32_t>(col_iter.index2()));
+	  write(o, static_cast<int32_t>(*col_iter));
+	}
+    }
+
+    /* reads the nonzeros written by writeSigma into an empty sigma of matching dimension */
+    inline bool readSigma(std::istream& i, sigma_matrix& sigma) {
+      int64_t dimension, nnz;
+      if (!read(i, dimension) || !read(i, nnz) || dimension != sigma.dimension || nnz < 0)
+	return false;
+
+      std::vector<int32_t> triples(3 * nnz);
+      if (nnz > 0 && !i.read(reinterpret_cast<char*>(triples.data()), triples.size() * sizeof(int32_t)).good())
+	return false;
+
+      for (int64_t k = 0; k < nnz; k++) {
+	const int32_t row = triples[3*k], col = triples[3*k + 1];
+	if (row < 0 || row >= dimension || col < 0 || col >= dimension)
+	  return false;
+	sigma.insert(row, col, triples[3*k + 2]);
+      }
+      return true;
+    }
+  }
+}
+
+#endif
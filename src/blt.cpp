@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis.hpp>
+
+#include <algorithm>
+
+#include "matching.hpp"
+
+namespace daestruct {
+  namespace analysis {
+
+    BLT blockTriangular(const BipartiteGraph& graph, const std::vector<int>& rowMatch, const std::vector<int>& colMatch) {
+      const int n = graph.rows;
+
+      BLT blt;
+      blt.equations.reserve(n);
+      blt.variables.reserve(n);
+      blt.block_start.push_back(0);
+
+      /* iterative Tarjan, the components are completed dependencies first */
+      std::vector<int> index(n, -1), low(n);
+      std::vector<std::size_t> next(n);
+      std::vector<bool> onStack(n, false);
+      std::vector<int> stack, call;
+      int counter = 0;
+
+      for (int root = 0; root < n; root++) {
+	if (index[root] >= 0)
+	  continue;
+
+	call.push_back(root);
+	while (!call.empty()) {
+	  const int i = call.back();
+	  if (index[i] < 0) {
+	    index[i] = low[i] = counter++;
+	    next[i] = graph.start[i];
+	    stack.push_back(i);
+	    onStack[i] = true;
+	  }
+
+	  bool descended = false;
+	  while (next[i] < graph.start[i + 1]) {
+	    const int k = colMatch[graph.adjacent[next[i]]];
+	    if (index[k] < 0) {
+	      call.push_back(k);
+	      descended = true;
+	      break;
+	    }
+	    if (onStack[k])
+	      low[i] = std::min(low[i], index[k]);
+	    next[i]++;
+	  }
+	  if (descended)
+	    continue;
+
+	  call.pop_back();
+	  if (!call.empty()) {
+	    const int parent = call.back();
+	    low[parent] = std::min(low[parent], low[i]);
+	    next[parent]++;
+	  }
+
+	  if (low[i] == index[i]) {
+	    int k;
+	    do {
+	      k = stack.back();
+	      stack.pop_back();
+	      onStack[k] = false;
+	      blt.equations.push_back(k);
+	      blt.variables.push_back(rowMatch[k]);
+	    } while (k != i);
+	    blt.block_start.push_back(blt.equations.size());
+	  }
+	}
+      }
+
+      return blt;
+    }
+
+    BLT bltDecomposition(const sigma_matrix& sigma, const AnalysisResult& result) {
+      const std::vector<int>& c = result.c;
+      const std::vector<int>& d = result.d;
+
+      /* equation i depends on the equation that is solved for an unknown of i */
+      const BipartiteGraph jacobian = incidence(sigma, [&](int i, int j, int value) { return -value == d[j] - c[i]; });
+
+      return blockTriangular(jacobian, result.row_assignment, result.col_assignment);
+    }
+  }
+}
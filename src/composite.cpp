@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/composite.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "warm_start.hpp"
+
+namespace daestruct {
+  namespace analysis {
+
+    namespace {
+      typedef ComponentTemplate::Entry Entry;
+
+      bool byPosition(const Entry& a, const Entry& b) {
+	return a.equation < b.equation || (a.equation == b.equation && a.variable < b.variable);
+      }
+
+      /* sort the entries and keep the highest derivative of duplicates */
+      void normalize(std::vector<Entry>& entries) {
+	std::sort(entries.begin(), entries.end(), byPosition);
+	unsigned int k = 0;
+	for (unsigned int e = 0; e < entries.size(); e++)
+	  if (k > 0 && entries[k - 1].equation == entries[e].equation && entries[k - 1].variable == entries[e].variable)
+	    entries[k - 1].derivative = std::max(entries[k - 1].derivative, entries[e].derivative);
+	  else
+	    entries[k++] = entries[e];
+	entries.resize(k);
+      }
+    }
+
+    int CompositeProblem::addTemplate(const ComponentTemplate& component) {
+      templates.push_back(component);
+      solutions.push_back(TemplateSolution());
+      return templates.size() - 1;
+    }
+
+    int CompositeProblem::instantiate(int component, const std::vector<int>& bindings) {
+      const ComponentTemplate& t = templates[component];
+      if ((int)bindings.size() != t.interfaces)
+	throw std::invalid_argument("wrong number of interface bindings");
+
+      instances.push_back(Instance{component, equationCount, variableCount, bindings});
+      equationCount += t.equations;
+      variableCount += t.variables;
+      return instances.size() - 1;
+    }
+
+    const CompositeProblem::TemplateSolution& CompositeProblem::solve(int component) {
+      TemplateSolution& solution = solutions[component];
+      const ComponentTemplate& t = templates[component];
+      if ((int)solution.rowsol.size() == t.equations && (int)solution.v.size() == t.variables)
+	return solution;
+
+      std::vector<Entry> local(t.local);
+      normalize(local);
+
+      LocalSolution padded = solveLocal(t.equations, t.variables, local);
+      solution.rowsol = std::move(padded.rowsol);
+      solution.u = std::move(padded.u);
+      solution.v = std::move(padded.v);
+      return solution;
+    }
+
+    InputProblem CompositeProblem::flatten() const {
+      std::vector<Entry> entries(global);
+      for (const Instance& instance : instances) {
+	const ComponentTemplate& t = templates[instance.component];
+	for (const Entry& e : t.local)
+	  entries.push_back(Entry{instance.firstEquation + e.equation, instance.firstVariable + e.variable, e.derivative});
+	for (const Entry& e : t.interface)
+	  entries.push_back(Entry{instance.firstEquation + e.equation, instance.bindings[e.variable], e.derivative});
+      }
+      normalize(entries);
+
+      InputProblem problem(std::max(equationCount, variableCount));
+      problem.options = options;
+      for (const Entry& e : entries)
+	problem.sigma.insert(e.equation, e.variable, -e.derivative);
+      return problem;
+    }
+
+    AnalysisResult CompositeProblem::analyse() {
+      if (equationCount != variableCount)
+	throw std::invalid_argument("composite problem is not square");
+
+      const int n = equationCount;
+      const InputProblem problem = flatten();
+      const sigma_matrix& sigma = problem.sigma;
+
+      /* warm start from the template solutions */
+      std::vector<int> rowsol(n, -1), colsol(n, -1), v(n, 0);
+      for (const Instance& instance : instances) {
+	const TemplateSolution& solution = solve(instance.component);
+	for (unsigned int e = 0; e < solution.rowsol.size(); e++)
+	  if (solution.rowsol[e] >= 0) {
+	    const int i = instance.firstEquation + e, j = instance.firstVariable + solution.rowsol[e];
+	    rowsol[i] = j;
+	    colsol[j] = i;
+	  }
+	for (unsigned int j = 0; j < solution.v.size(); j++)
+	  v[instance.firstVariable + j] = solution.v[j];
+      }
+
+      AnalysisResult result;
+      completeAssignment(sigma, rowsol, colsol, v, result);
+
+      problem.solveOffsets(result);
+      if (options.blt && result.bound_witness < 0)
+	result.blt = bltDecomposition(sigma, result);
+
+      return result;
+    }
+  }
+}
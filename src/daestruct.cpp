@@ -18,11 +18,23 @@
  */
 
 #include <daestruct.h>
+#include <daestruct/result_cache.h>
+#include <daestruct/solution_scheme.h>
+#include <daestruct/lap_solver.h>
 
 #include <daestruct/analysis.hpp>
 #include <daestruct/sigma_matrix.hpp>
 #include <daestruct/c_cpp_interface.hpp>
 
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "batch_assignment.hpp"
+#include "dense_assignment.hpp"
+#include "lap.hpp"
+
 extern "C" {
 
   using namespace daestruct::analysis;
@@ -40,7 +52,102 @@ extern "C" {
   }
 
   struct daestruct_result* daestruct_analyse(struct daestruct_input* problem) {
-    return static_cast<daestruct_result*>(new AnalysisResult(problem->pryceAlgorithm()));
+    try {
+      return static_cast<daestruct_result*>(new AnalysisResult(problem->pryceAlgorithm()));
+    } catch (const StructurallySingular& e) {
+      std::cerr << e.what() << std::endl;
+      return nullptr;
+    }
+  }
+
+  int daestruct_analyse_dense(int dimension, const int* derivatives, int* c, int* d) {
+    if (dimension < 0 || dimension > dense_max_dimension)
+      return -1;
+
+    const DenseSigma sigma(dimension, derivatives);
+    int rowsol[dense_max_dimension];
+    if (!denseAssignment(sigma, rowsol))
+      return -1;
+
+    for (int k = 0; k < dimension; k++)
+      c[k] = d[k] = 0;
+    denseOffsets(sigma, rowsol, c, d, -1);
+    return 0;
+  }
+
+  int daestruct_analyse_batch(int count, int dimension, const int* derivatives, int* c, int* d, int* status) {
+    if (dimension < 0 || dimension > dense_max_dimension)
+      return -1;
+
+    const int n = dimension;
+    BatchSigma sigma(n);
+    std::vector<int> rowsol(n * batch_lanes), lane_c(n * batch_lanes), lane_d(n * batch_lanes);
+    int singular[batch_lanes];
+    int failed = 0;
+
+    for (int first = 0; first < count; first += batch_lanes) {
+      const int lanes = std::min(batch_lanes, count - first);
+      /* large batches exceed int in the offsets below */
+      sigma.load(lanes, derivatives + static_cast<std::size_t>(first) * n * n);
+      batchAssignment(sigma, rowsol.data(), singular);
+      batchOffsets(sigma, rowsol.data(), singular, lane_c.data(), lane_d.data());
+
+      for (int l = 0; l < lanes; l++) {
+	status[first + l] = singular[l] ? -1 : 0;
+	failed += singular[l];
+	const std::size_t offset = static_cast<std::size_t>(first + l) * n;
+	for (int k = 0; k < n; k++) {
+	  c[offset + k] = lane_c[k * batch_lanes + l];
+	  d[offset + k] = lane_d[k * batch_lanes + l];
+	}
+      }
+    }
+    return failed;
+  }
+
+  int daestruct_analyse_rows(int dimension, daestruct_row_callback rows, void* data, int* c, int* d) {
+    const daestruct::callback_matrix sigma(dimension, rows, data, true);
+
+    /* lap() needs an entry in every row and column */
+    std::vector<bool> covered(dimension, false);
+    for (int i = 0; i < dimension; i++) {
+      const auto row = sigma.findRow(i);
+      if (row.begin() == row.end())
+	return -1;
+      for (auto col_iter = row.begin(); col_iter != row.end(); ++col_iter) {
+	const int j = col_iter.index2();
+	if (j < 0 || j >= dimension)
+	  return -1;
+	covered[j] = true;
+      }
+    }
+    if (std::find(covered.begin(), covered.end(), false) != covered.end())
+      return -1;
+
+    solution assignment;
+    try {
+      assignment = lap(sigma);
+    } catch (const std::runtime_error& e) {
+      return -1;
+    }
+
+    std::vector<int> cv(dimension, 0), dv(dimension, 0);
+    solveByFixedPoint(assignment.rowsol, sigma, cv, dv);
+    std::copy(cv.begin(), cv.end(), c);
+    std::copy(dv.begin(), dv.end(), d);
+    return 0;
+  }
+
+  struct daestruct_result* daestruct_analyse_bounded(struct daestruct_input* problem, int max_offset) {
+    const int old_bound = problem->options.max_offset;
+    problem->options.max_offset = max_offset;
+    struct daestruct_result* result = daestruct_analyse(problem);
+    problem->options.max_offset = old_bound;
+    return result;
+  }
+
+  int daestruct_result_bound_witness(struct daestruct_result* result) {
+    return result->bound_witness;
   }
 
   int daestruct_result_equation_index(struct daestruct_result* result, int equation) {
@@ -51,7 +158,131 @@ extern "C" {
     return result->d[variable];
   }
 
+  void daestruct_input_enable_blt(struct daestruct_input* problem, int enable) {
+    problem->options.blt = enable;
+  }
+
+  void daestruct_input_enable_symmetry(struct daestruct_input* problem, int enable) {
+    problem->options.symmetry = enable;
+  }
+
+  void daestruct_input_enable_reordering(struct daestruct_input* problem, int enable) {
+    problem->options.reorder = enable;
+  }
+
+  int daestruct_result_blt_blocks(struct daestruct_result* result) {
+    return result->blt.blocks();
+  }
+
+  const int* daestruct_result_blt_block_start(struct daestruct_result* result) {
+    return result->blt.block_start.data();
+  }
+
+  const int* daestruct_result_blt_equations(struct daestruct_result* result) {
+    return result->blt.equations.data();
+  }
+
+  const int* daestruct_result_blt_variables(struct daestruct_result* result) {
+    return result->blt.variables.data();
+  }
+
   void daestruct_result_delete(struct daestruct_result* result) {
     delete result;
   }
+
+  struct daestruct_cache* daestruct_cache_create(const char* directory, unsigned long long max_bytes) {
+    return static_cast<daestruct_cache*>(new ResultCache(directory, max_bytes));
+  }
+
+  void daestruct_cache_delete(struct daestruct_cache* cache) {
+    delete cache;
+  }
+
+  struct daestruct_result* daestruct_analyse_cached(struct daestruct_input* problem, struct daestruct_cache* cache) {
+    try {
+      return static_cast<daestruct_result*>(new AnalysisResult(cache->analyse(*problem)));
+    } catch (const StructurallySingular& e) {
+      std::cerr << e.what() << std::endl;
+      return nullptr;
+    }
+  }
+
+  struct daestruct_scheme* daestruct_scheme_create(struct daestruct_result* result) {
+    return static_cast<daestruct_scheme*>(new SolutionScheme(solutionScheme(*result)));
+  }
+
+  void daestruct_scheme_delete(struct daestruct_scheme* scheme) {
+    delete scheme;
+  }
+
+  int daestruct_scheme_first_stage(struct daestruct_scheme* scheme) {
+    return scheme->first_stage;
+  }
+
+  int daestruct_scheme_equations(struct daestruct_scheme* scheme, int stage, const int** equations) {
+    const long k = static_cast<long>(stage) - scheme->first_stage;
+    if (k < 0 || k >= scheme->stages()) {
+      *equations = nullptr;
+      return 0;
+    }
+    *equations = scheme->equations.data();
+    return scheme->equation_count[k];
+  }
+
+  int daestruct_scheme_variables(struct daestruct_scheme* scheme, int stage, const int** variables) {
+    const long k = static_cast<long>(stage) - scheme->first_stage;
+    if (k < 0 || k >= scheme->stages()) {
+      *variables = nullptr;
+      return 0;
+    }
+    *variables = scheme->variables.data();
+    return scheme->variable_count[k];
+  }
+
+  long daestruct_scheme_dof(struct daestruct_scheme* scheme) {
+    return scheme->dof;
+  }
+
+  struct daestruct_lap_solver* daestruct_lap_solver_create(void) {
+    return static_cast<daestruct_lap_solver*>(new daestruct::LapSolver());
+  }
+
+  void daestruct_lap_solver_delete(struct daestruct_lap_solver* solver) {
+    delete solver;
+  }
+
+  int daestruct_lap_solve(struct daestruct_lap_solver* solver, int n, const int64_t* row_start,
+			  const int* columns, const int64_t* costs) {
+    return daestruct_lap_solve_warm(solver, n, row_start, columns, costs, nullptr, nullptr);
+  }
+
+  int daestruct_lap_solve_warm(struct daestruct_lap_solver* solver, int n, const int64_t* row_start,
+			       const int* columns, const int64_t* costs,
+			       const int* row_assignment, const int* column_duals) {
+    try {
+      return solver->solve(n, row_start, columns, costs, row_assignment, column_duals) ? 0 : 1;
+    } catch (const std::invalid_argument& e) {
+      return -1;
+    }
+  }
+
+  int64_t daestruct_lap_cost(struct daestruct_lap_solver* solver) {
+    return solver->cost();
+  }
+
+  const int* daestruct_lap_row_assignment(struct daestruct_lap_solver* solver) {
+    return solver->row_assignment().data();
+  }
+
+  const int* daestruct_lap_col_assignment(struct daestruct_lap_solver* solver) {
+    return solver->col_assignment().data();
+  }
+
+  const int64_t* daestruct_lap_row_duals(struct daestruct_lap_solver* solver) {
+    return solver->row_duals().data();
+  }
+
+  const int* daestruct_lap_column_duals(struct daestruct_lap_solver* solver) {
+    return solver->column_duals().data();
+  }
 }
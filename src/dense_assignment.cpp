@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dense_assignment.hpp"
+
+#include <climits>
+
+namespace daestruct {
+  namespace analysis {
+
+    namespace {
+      inline uint64_t bit(int j) { return uint64_t(1) << j; }
+
+      inline int lowest(uint64_t set) { return __builtin_ctzll(set); }
+    }
+
+    DenseSigma::DenseSigma(const sigma_matrix& sigma) : dimension(sigma.dimension) {
+      for (int i = 0; i < dimension; i++)
+	rows[i] = 0;
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  rows[col_iter.index1()] |= bit(col_iter.index2());
+	  cost[col_iter.index1()][col_iter.index2()] = *col_iter;
+	}
+    }
+
+    DenseSigma::DenseSigma(int n, const int* derivatives) : dimension(n) {
+      for (int i = 0; i < n; i++) {
+	rows[i] = 0;
+	for (int j = 0; j < n; j++)
+	  if (derivatives[i * n + j] >= 0) {
+	    rows[i] |= bit(j);
+	    cost[i][j] = -derivatives[i * n + j];
+	  }
+      }
+    }
+
+    bool denseAssignment(const DenseSigma& sigma, int* rowsol) {
+      const int n = sigma.dimension;
+      int u[dense_max_dimension], v[dense_max_dimension];
+      int match[dense_max_dimension], way[dense_max_dimension], minv[dense_max_dimension];
+      for (int k = 0; k < n; k++) {
+	u[k] = v[k] = 0;
+	match[k] = -1;
+      }
+
+      for (int i = 0; i < n; i++) {
+	/* columns on the shortest path tree and columns with a tentative distance */
+	uint64_t used = 0, reached = 0;
+	int row = i, j0 = -1;
+
+	for (;;) {
+	  for (uint64_t todo = sigma.rows[row] & ~used; todo; todo &= todo - 1) {
+	    const int j = lowest(todo);
+	    const int h = sigma.cost[row][j] - u[row] - v[j];
+	    if (!(reached & bit(j)) || h < minv[j]) {
+	      minv[j] = h;
+	      way[j] = j0;
+	      reached |= bit(j);
+	    }
+	  }
+
+	  const uint64_t candidates = reached & ~used;
+	  if (!candidates)
+	    return false;
+
+	  int j1 = lowest(candidates), delta = minv[j1];
+	  for (uint64_t todo = candidates & (candidates - 1); todo; todo &= todo - 1) {
+	    const int j = lowest(todo);
+	    if (minv[j] < delta) {
+	      delta = minv[j];
+	      j1 = j;
+	    }
+	  }
+
+	  u[i] += delta;
+	  for (uint64_t todo = used; todo; todo &= todo - 1) {
+	    const int j = lowest(todo);
+	    u[match[j]] += delta;
+	    v[j] -= delta;
+	  }
+	  for (uint64_t todo = candidates; todo; todo &= todo - 1)
+	    minv[lowest(todo)] -= delta;
+
+	  used |= bit(j1);
+	  j0 = j1;
+	  if (match[j1] < 0)
+	    break;
+	  row = match[j1];
+	}
+
+	/* augment along the tree path back to row i */
+	while (j0 >= 0) {
+	  const int j = way[j0];
+	  match[j0] = j >= 0 ? match[j] : i;
+	  j0 = j;
+	}
+      }
+
+      for (int j = 0; j < n; j++)
+	rowsol[match[j]] = j;
+      return true;
+    }
+
+    int denseOffsets(const DenseSigma& sigma, const int* rowsol, int* c, int* d, int max_offset) {
+      const int n = sigma.dimension;
+      bool converged = false;
+
+      while (!converged) {
+	converged = true;
+
+	for (int i = 0; i < n; i++)
+	  for (uint64_t todo = sigma.rows[i]; todo; todo &= todo - 1) {
+	    const int j = lowest(todo);
+	    const int a = c[i] - sigma.cost[i][j];
+	    if (a > d[j])
+	      d[j] = a;
+	  }
+
+	for (int i = 0; i < n; i++) {
+	  const int c2 = d[rowsol[i]] + sigma.cost[i][rowsol[i]];
+	  if (c[i] != c2)
+	    converged = false;
+	  c[i] = c2;
+	  if (max_offset >= 0 && c2 > max_offset)
+	    return i;
+	}
+      }
+      return -1;
+    }
+  }
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_DENSE_ASSIGNMENT_HPP
+#define DAE_DENSE_ASSIGNMENT_HPP
+
+#include <cstdint>
+
+#include <daestruct/sigma_matrix.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /* problems up to this dimension are solved by the dense engine */
+    const int dense_max_dimension = 64;
+
+    /**
+     * Cost matrix of a small problem in fixed size storage: rows[i] is the
+     * bitset of the unknowns of equation i, cost[i][j] is only valid for
+     * those. Nothing is allocated, so the whole problem lives on the stack.
+     */
+    struct DenseSigma {
+      int dimension;
+      uint64_t rows[dense_max_dimension];
+      int cost[dense_max_dimension][dense_max_dimension];
+
+      /* sigma.dimension must not exceed dense_max_dimension */
+      explicit DenseSigma(const sigma_matrix& sigma);
+
+      /* row major derivatives, negative ones are structural zeros */
+      DenseSigma(int n, const int* derivatives);
+    };
+
+    /**
+     * Optimal assignment by the Hungarian method (shortest augmenting paths
+     * over the row bitsets), returns false if sigma is structurally singular
+     */
+    bool denseAssignment(const DenseSigma& sigma, int* rowsol);
+
+    /**
+     * solveByFixedPoint for a DenseSigma, c and d must be initialised (to 0 for the smallest offsets)
+     */
+    int denseOffsets(const DenseSigma& sigma, const int* rowsol, int* c, int* d, int max_offset);
+  }
+}
+
+#endif
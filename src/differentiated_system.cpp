@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/differentiated_system.hpp>
+
+#include <algorithm>
+
+namespace daestruct {
+  namespace analysis {
+
+    DifferentiatedSystem differentiatedSystem(const sigma_matrix& sigma, const AnalysisResult& result) {
+      const int n = sigma.dimension;
+      const std::vector<int>& c = result.c;
+      const std::vector<int>& d = result.d;
+
+      DifferentiatedSystem system;
+      system.equation_start.assign(n + 1, 0);
+      system.variable_start.assign(n + 1, 0);
+      for (int i = 0; i < n; i++) {
+	system.equation_start[i + 1] = system.equation_start[i] + c[i] + 1;
+	system.variable_start[i + 1] = system.variable_start[i] + d[i] + 1;
+      }
+
+      SparsityPattern& incidence = system.incidence;
+      incidence.rows = system.equation_start[n];
+      incidence.columns = system.variable_start[n];
+
+      SparsityPattern& jacobian = system.jacobian;
+      jacobian.rows = jacobian.columns = n;
+
+      /* entries of sigma are sorted by column within a row, hence all patterns are sorted */
+      for (int i = 0; i < n; i++) {
+	auto row_iter = sigma.findRow(i);
+	for (int q = 0; q <= c[i]; q++) {
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	    const int j = col_iter.index2();
+	    for (int r = 0; r <= -*col_iter + q; r++)
+	      incidence.column.push_back(system.variable_start[j] + r);
+	  }
+	  incidence.row_start.push_back(incidence.column.size());
+	}
+
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	  if (-*col_iter == d[col_iter.index2()] - c[i])
+	    jacobian.column.push_back(col_iter.index2());
+	jacobian.row_start.push_back(jacobian.column.size());
+      }
+
+      const int max_d = n > 0 ? *std::max_element(d.begin(), d.end()) : 0;
+      std::vector<int> local(n);
+      for (int k = -max_d; k <= 0; k++) {
+	StageJacobian stage;
+	stage.k = k;
+
+	std::fill(local.begin(), local.end(), -1);
+	for (int j = 0; j < n; j++)
+	  if (d[j] + k >= 0) {
+	    local[j] = stage.variables.size();
+	    stage.variables.push_back(j);
+	  }
+
+	for (int i = 0; i < n; i++) {
+	  if (c[i] + k < 0)
+	    continue;
+	  stage.equations.push_back(i);
+	  /* every Jacobian entry of an active equation has d_j + k >= c_i + k >= 0 */
+	  for (int e = jacobian.row_start[i]; e < jacobian.row_start[i + 1]; e++)
+	    stage.pattern.column.push_back(local[jacobian.column[e]]);
+	  stage.pattern.row_start.push_back(stage.pattern.column.size());
+	}
+
+	stage.pattern.rows = stage.equations.size();
+	stage.pattern.columns = stage.variables.size();
+	system.stages.push_back(std::move(stage));
+      }
+
+      return system;
+    }
+  }
+}
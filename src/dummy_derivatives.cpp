@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/dummy_derivatives.hpp>
+
+#include <algorithm>
+
+#include "matching.hpp"
+
+namespace daestruct {
+  namespace analysis {
+
+    std::vector<DummyDerivativeLevel> dummyDerivatives(const sigma_matrix& sigma, const AnalysisResult& result, int block) {
+      const BLT& blt = result.blt;
+      const std::vector<int>& c = result.c;
+      const std::vector<int>& d = result.d;
+      const int begin = blt.block_start[block], end = blt.block_start[block + 1];
+
+      /* the previous selection, sorted */
+      std::vector<int> previous;
+      int max_c = 0;
+      for (int k = begin; k < end; k++) {
+	previous.push_back(blt.variables[k]);
+	max_c = std::max(max_c, c[blt.equations[k]]);
+      }
+      std::sort(previous.begin(), previous.end());
+
+      std::vector<DummyDerivativeLevel> levels;
+      for (int level = 1; level <= max_c; level++) {
+	DummyDerivativeLevel step;
+	step.block = block;
+	step.level = level;
+
+	for (int k = begin; k < end; k++) {
+	  const int i = blt.equations[k];
+	  if (c[i] < level)
+	    continue;
+	  step.equations.push_back(i);
+
+	  /* Jacobian entries of i among the previous selection */
+	  auto row_iter = sigma.findRow(i);
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	    const int j = col_iter.index2();
+	    if (-*col_iter == d[j] - c[i] && std::binary_search(previous.begin(), previous.end(), j))
+	      step.candidates.push_back(j);
+	  }
+	}
+
+	std::sort(step.candidates.begin(), step.candidates.end());
+	step.candidates.erase(std::unique(step.candidates.begin(), step.candidates.end()), step.candidates.end());
+
+	/* match the equations into the candidate columns of their Jacobian rows */
+	BipartiteGraph jacobian(step.equations.size(), step.candidates.size());
+	for (const int i : step.equations) {
+	  auto row_iter = sigma.findRow(i);
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	    const int j = col_iter.index2();
+	    auto candidate = std::lower_bound(step.candidates.begin(), step.candidates.end(), j);
+	    if (-*col_iter == d[j] - c[i] && candidate != step.candidates.end() && *candidate == j)
+	      jacobian.addEdge(candidate - step.candidates.begin());
+	  }
+	  jacobian.endRow();
+	}
+
+	std::vector<int> rowMatch, colMatch;
+	maximumMatching(jacobian, rowMatch, colMatch);
+	for (const int m : rowMatch)
+	  if (m >= 0)
+	    step.selected.push_back(step.candidates[m]);
+
+	previous = step.selected;
+	std::sort(previous.begin(), previous.end());
+	levels.push_back(std::move(step));
+      }
+
+      return levels;
+    }
+
+    std::vector<DummyDerivativeLevel> dummyDerivatives(const sigma_matrix& sigma, const AnalysisResult& result) {
+      std::vector<DummyDerivativeLevel> levels;
+      for (int b = 0; b < result.blt.blocks(); b++)
+	for (auto& level : dummyDerivatives(sigma, result, b))
+	  levels.push_back(std::move(level));
+      return levels;
+    }
+  }
+}
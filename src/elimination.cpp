@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "elimination.hpp"
+
+#include <algorithm>
+#include <climits>
+
+namespace daestruct {
+  namespace analysis {
+
+    /* work items: rows are stored as is, classes as -1 - class */
+    inline int classItem(int cls) { return -1 - cls; }
+
+    Elimination::Elimination(const sigma_matrix& s) :
+      sigma(s), n(s.dimension), singular(false),
+      rowStart(s.dimension + 1), rowDegree(s.dimension), rowAlive(s.dimension, true),
+      classRows(s.dimension), members(s.dimension), classDegree(s.dimension), shift(s.dimension),
+      classNode(s.dimension), classAlive(s.dimension, true), local(s.dimension) {
+
+      entryClass.reserve(sigma.nnz());
+      entryValue.reserve(sigma.nnz());
+      entryIndex.reserve(sigma.nnz());
+
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++) {
+	const int i = row_iter.index1();
+	rowStart[i] = entryClass.size();
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  const int j = col_iter.index2();
+	  entryIndex[key(i, j)] = entryClass.size();
+	  entryClass.push_back(j);
+	  entryValue.push_back(-*col_iter);
+	  classRows[j].push_back(i);
+	}
+	rowDegree[i] = entryClass.size() - rowStart[i];
+      }
+      /* rows without entries have not been visited */
+      rowStart[n] = entryClass.size();
+      for (int i = n - 1; i >= 0; i--)
+	if (rowDegree[i] == 0)
+	  rowStart[i] = rowStart[i + 1];
+
+      for (int j = 0; j < n; j++) {
+	classDegree[j] = classRows[j].size();
+	classNode[j] = j;
+	members[j].push_back(j);
+      }
+
+      run();
+      if (!singular)
+	buildCore();
+    }
+
+    long long Elimination::findEntry(int row, int cls) const {
+      auto it = entryIndex.find(key(row, cls));
+      return it == entryIndex.end() ? -1 : it->second;
+    }
+
+    void Elimination::removeEntry(int row, int cls) {
+      auto it = entryIndex.find(key(row, cls));
+      entryClass[it->second] = -1;
+      entryIndex.erase(it);
+      rowDegree[row]--;
+    }
+
+    void Elimination::force(int i, int cls) {
+      forced.push_back(std::make_pair(i, classNode[cls]));
+
+      rowAlive[i] = false;
+      for (std::size_t e = rowStart[i]; e < rowStart[i + 1]; e++) {
+	const int other = entryClass[e];
+	if (other >= 0 && other != cls) {
+	  classDegree[other]--;
+	  work.push_back(classItem(other));
+	}
+      }
+
+      classAlive[cls] = false;
+      for (int r : classRows[cls])
+	if (rowAlive[r]) {
+	  removeEntry(r, cls);
+	  work.push_back(r);
+	}
+    }
+
+    void Elimination::contract(int i) {
+      long long e0 = -1, e1 = -1;
+      for (std::size_t e = rowStart[i]; e < rowStart[i + 1]; e++)
+	if (entryClass[e] >= 0)
+	  (e0 < 0 ? e0 : e1) = e;
+
+      rowAlive[i] = false;
+
+      /* merge the class with the shorter row list into the other one */
+      int J = entryClass[e0], K = entryClass[e1];
+      int a = entryValue[e0] + shift[J], b = entryValue[e1] + shift[K];
+      if (classRows[J].size() < classRows[K].size()) {
+	std::swap(J, K);
+	std::swap(a, b);
+      }
+      classDegree[J]--;
+      classDegree[K]--;
+
+      /* assigning i to K costs b on the side of J and vice versa */
+      shift[J] += b;
+      for (int c : members[K]) {
+	local[c] += shift[K] + a - shift[J];
+	members[J].push_back(c);
+      }
+      std::vector<int>().swap(members[K]);
+
+      for (int r : classRows[K]) {
+	if (!rowAlive[r])
+	  continue;
+
+	const long long eK = findEntry(r, K);
+	const long long eJ = findEntry(r, J);
+	const int valueK = entryValue[eK] + shift[K] + a;
+
+	if (eJ >= 0) {
+	  entryValue[eJ] = std::max(entryValue[eJ] + shift[J], valueK) - shift[J];
+	  removeEntry(r, K);
+	  work.push_back(r);
+	} else {
+	  entryIndex.erase(key(r, K));
+	  entryIndex[key(r, J)] = eK;
+	  entryClass[eK] = J;
+	  entryValue[eK] = valueK - shift[J];
+	  classRows[J].push_back(r);
+	  classDegree[J]++;
+	}
+      }
+      std::vector<int>().swap(classRows[K]);
+
+      classAlive[K] = false;
+      nodeRow.push_back(i);
+      nodeLeft.push_back(classNode[J]);
+      nodeRight.push_back(classNode[K]);
+      classNode[J] = n + nodeRow.size() - 1;
+
+      work.push_back(classItem(J));
+    }
+
+    void Elimination::run() {
+      for (int i = 0; i < n; i++)
+	work.push_back(i);
+      for (int j = 0; j < n; j++)
+	work.push_back(classItem(j));
+
+      while (!work.empty() && !singular) {
+	const int item = work.back();
+	work.pop_back();
+
+	if (item >= 0) {
+	  const int i = item;
+	  if (!rowAlive[i])
+	    continue;
+
+	  if (rowDegree[i] == 0)
+	    singular = true;
+	  else if (rowDegree[i] == 1) {
+	    for (std::size_t e = rowStart[i]; e < rowStart[i + 1]; e++)
+	      if (entryClass[e] >= 0) {
+		force(i, entryClass[e]);
+		break;
+	      }
+	  } else if (rowDegree[i] == 2)
+	    contract(i);
+	} else {
+	  const int cls = -1 - item;
+	  if (!classAlive[cls])
+	    continue;
+
+	  if (classDegree[cls] == 0)
+	    singular = true;
+	  else if (classDegree[cls] == 1) {
+	    for (int r : classRows[cls])
+	      if (rowAlive[r]) {
+		force(r, cls);
+		break;
+	      }
+	  }
+	}
+      }
+    }
+
+    void Elimination::buildCore() {
+      std::vector<int> coreIndex(n, -1);
+      for (int j = 0; j < n; j++)
+	if (classAlive[j]) {
+	  coreIndex[j] = coreClasses.size();
+	  coreClasses.push_back(j);
+	}
+      for (int i = 0; i < n; i++)
+	if (rowAlive[i])
+	  coreRows.push_back(i);
+
+      if (coreRows.size() != coreClasses.size()) {
+	singular = true;
+	return;
+      }
+
+      core.reset(new sigma_matrix(coreRows.size()));
+      std::vector<std::pair<int, int>> row;
+      for (unsigned int k = 0; k < coreRows.size(); k++) {
+	const int i = coreRows[k];
+	row.clear();
+	for (std::size_t e = rowStart[i]; e < rowStart[i + 1]; e++)
+	  if (entryClass[e] >= 0)
+	    row.push_back(std::make_pair(coreIndex[entryClass[e]], entryValue[e] + shift[entryClass[e]]));
+
+	/* insert in column order, so ublas only appends */
+	std::sort(row.begin(), row.end());
+	for (const auto& entry : row)
+	  core->insert(k, entry.first, -entry.second);
+      }
+    }
+
+    void Elimination::expand(const std::vector<int>& reduced_rowsol, std::vector<int>& rowsol, std::vector<int>& colsol) const {
+      const int nodes = n + nodeRow.size();
+
+      /* final offset of every original column */
+      std::vector<int> offset(n);
+      for (int j = 0; j < n; j++)
+	for (int c : members[j])
+	  offset[c] = local[c] + shift[j];
+
+      /* number the leaves such that every subtree of the merge tree is an interval */
+      std::vector<int> lo(nodes), hi(nodes);
+      std::vector<bool> hasParent(nodes, false);
+      for (unsigned int k = 0; k < nodeRow.size(); k++)
+	hasParent[nodeLeft[k]] = hasParent[nodeRight[k]] = true;
+
+      int next = 0;
+      std::vector<std::pair<int, bool>> stack;
+      for (int root = 0; root < nodes; root++) {
+	if (hasParent[root])
+	  continue;
+	stack.push_back(std::make_pair(root, false));
+	while (!stack.empty()) {
+	  const int node = stack.back().first;
+	  const bool done = stack.back().second;
+	  stack.pop_back();
+	  if (node < n) {
+	    lo[node] = next++;
+	    hi[node] = next;
+	  } else if (done) {
+	    lo[node] = lo[nodeLeft[node - n]];
+	    hi[node] = hi[nodeRight[node - n]];
+	  } else {
+	    stack.push_back(std::make_pair(node, true));
+	    stack.push_back(std::make_pair(nodeRight[node - n], false));
+	    stack.push_back(std::make_pair(nodeLeft[node - n], false));
+	  }
+	}
+      }
+
+      /* best column for a row within a subtree, w.r.t. the offsets of the contraction */
+      auto best = [&](int row, int node) {
+	int column = -1, value = INT_MIN;
+	auto row_iter = sigma.findRow(row);
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  const int c = col_iter.index2();
+	  if (lo[c] >= lo[node] && lo[c] < hi[node] && -*col_iter + offset[c] > value) {
+	    value = -*col_iter + offset[c];
+	    column = c;
+	  }
+	}
+	return column;
+      };
+
+      /* (node, row, best column of row in node) */
+      struct task { int node; int row; int column; };
+      std::vector<task> tasks;
+      for (unsigned int k = 0; k < coreRows.size(); k++)
+	tasks.push_back(task{classNode[coreClasses[reduced_rowsol[k]]], coreRows[k], -1});
+      for (const auto& f : forced)
+	tasks.push_back(task{f.second, f.first, -1});
+
+      rowsol.assign(n, -1);
+      colsol.assign(n, -1);
+      while (!tasks.empty()) {
+	task t = tasks.back();
+	tasks.pop_back();
+
+	if (t.column < 0)
+	  t.column = best(t.row, t.node);
+
+	if (t.node < n) {
+	  rowsol[t.row] = t.node;
+	  colsol[t.node] = t.row;
+	} else {
+	  const int k = t.node - n;
+	  const int left = nodeLeft[k], right = nodeRight[k];
+	  if (lo[t.column] < hi[left]) {
+	    tasks.push_back(task{left, t.row, t.column});
+	    tasks.push_back(task{right, nodeRow[k], -1});
+	  } else {
+	    tasks.push_back(task{right, t.row, t.column});
+	    tasks.push_back(task{left, nodeRow[k], -1});
+	  }
+	}
+      }
+    }
+  }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_ELIMINATION_HPP
+#define DAE_ELIMINATION_HPP
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include <daestruct/sigma_matrix.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * Structural pre-processing of the assignment problem.
+     *
+     * Equations with a single unknown and unknowns in a single equation force
+     * their assignment and are removed. An equation with exactly two unknowns
+     * (like the alias uL = u2) is contracted: its unknowns are merged into one
+     * column, whose cost in every other equation is the better of the two ways
+     * to assign the contracted equation. The remaining (reduced) problem has the
+     * same optimal value, and every optimal assignment of it can be expanded to
+     * an optimal assignment of the original problem.
+     */
+    class Elimination {
+      const sigma_matrix& sigma;
+      const int n;
+      bool singular;
+
+      /* row entries (class, value - shift of class), in derivative terms; dead entries have class -1 */
+      std::vector<std::size_t> rowStart;
+      std::vector<int> entryClass;
+      std::vector<int> entryValue;
+      std::vector<int> rowDegree;
+      std::vector<bool> rowAlive;
+      std::unordered_map<long long, long long> entryIndex;
+
+      /* a class is a set of merged columns, named by one of them */
+      std::vector<std::vector<int>> classRows;
+      std::vector<std::vector<int>> members;
+      std::vector<int> classDegree;
+      std::vector<int> shift;
+      std::vector<int> classNode;
+      std::vector<bool> classAlive;
+
+      /* offset of an original column relative to the shift of its class */
+      std::vector<int> local;
+
+      /* merge tree, leaves are the original columns, inner node k is n + k */
+      std::vector<int> nodeRow;
+      std::vector<int> nodeLeft;
+      std::vector<int> nodeRight;
+
+      /* forced (row, node) assignments */
+      std::vector<std::pair<int, int>> forced;
+
+      std::vector<int> coreRows;
+      std::vector<int> coreClasses;
+      std::unique_ptr<sigma_matrix> core;
+
+      std::vector<int> work;
+
+      long long key(int row, int cls) const { return static_cast<long long>(row) * n + cls; }
+
+      long long findEntry(int row, int cls) const;
+      void removeEntry(int row, int cls);
+      void force(int row, int cls);
+      void contract(int row);
+      void run();
+      void buildCore();
+
+    public:
+      Elimination(const sigma_matrix& sigma);
+
+      /**
+       * false if the elimination hit a structurally singular part, the reduced problem is not valid then
+       */
+      bool valid() const { return !singular; }
+
+      const sigma_matrix& reduced() const { return *core; }
+
+      /**
+       * expand an optimal assignment of the reduced problem to the original problem
+       */
+      void expand(const std::vector<int>& reduced_rowsol, std::vector<int>& rowsol, std::vector<int>& colsol) const;
+    };
+  }
+}
+
+#endif
@@ -35,11 +35,10 @@
 
 */
 
-#include <cstring> //memset
 #include <iostream>
 #include <algorithm>
+#include <stdexcept>
 #include <boost/heap/d_ary_heap.hpp>
-#include <boost/timer/timer.hpp>
 #include "lap.hpp"
 #include "prettyprint.hpp"
 
@@ -70,11 +69,17 @@ struct augmentation_data {
   std::vector<int> ready;
   std::vector<bool> is_ready;
 
+  /* is a column in "scan"? */
+  std::vector<bool> in_scan;
+
   /* vector of previous rows for each column in the augmenting path */
   std::vector<int> prev;
 
   /* scan vector */
   std::vector<int> scan;
+
+  /* columns reached by the current search, only those are reset for the next one */
+  std::vector<int> touched;
   
   /* comparator implementation, based on distances */
   std::vector<int> dist;
@@ -84,29 +89,47 @@ struct augmentation_data {
   node_compare cmp;
   priority_queue pq;
 
-  augmentation_data(int dim) : in_todo(dim), is_ready(dim), prev(dim), dist(dim), handles(dim), cmp(&dist), pq(cmp) {
+  augmentation_data(int dim) : in_todo(dim), is_ready(dim), in_scan(dim), prev(dim), dist(dim), handles(dim), cmp(&dist), pq(cmp) {
+    pq.reserve(dim);
+  }
+
+  /* make room for dim columns, the flags of a reset workspace are all false */
+  void resize(int dim) {
+    if (static_cast<int>(dist.size()) >= dim)
+      return;
+    in_todo.resize(dim);
+    is_ready.resize(dim);
+    in_scan.resize(dim);
+    prev.resize(dim);
+    dist.resize(dim);
+    handles.resize(dim);
     pq.reserve(dim);
   }
 
-  void reset(int start) {
-    std::fill(is_ready.begin(), is_ready.end(), false);
-    std::fill(in_todo.begin(), in_todo.end(), false);
-    std::fill(prev.begin(), prev.end(), start);
+  /* a search only reaches a few columns, clearing all of them would make the augmentation quadratic */
+  void reset() {
+    for (const int j : touched)
+      is_ready[j] = in_scan[j] = in_todo[j] = false;
 
+    touched.clear();
     pq.clear();
     ready.clear();
     scan.clear();
   }
 };
 
-inline void augment(augmentation_data& data, const daestruct::sigma_matrix& assigncost, std::vector<int>& v, const int start, std::vector<int>& rowsol, std::vector<int>& colsol) {
-  data.reset(start);
+template<typename Matrix>
+inline void augment(augmentation_data& data, const Matrix& assigncost, std::vector<int>& v, const int start, std::vector<int>& rowsol, std::vector<int>& colsol) {
+  data.reset();
 
   auto start_row = assigncost.findRow(start);
 
   /* iterate twice to get correct order in queue */
-  for (auto col = start_row.begin(); col != start_row.end() ; col++)
+  for (auto col = start_row.begin(); col != start_row.end() ; col++) {
     data.dist[col.index2()] = *col - v[col.index2()];
+    data.prev[col.index2()] = start;
+    data.touched.push_back(col.index2());
+  }
 
   for (auto col = start_row.begin(); col != start_row.end() ; col++) {
     data.handles[col.index2()] = data.pq.push(col.index2());
@@ -122,18 +145,24 @@ inline void augment(augmentation_data& data, const daestruct::sigma_matrix& assi
       while (!data.pq.empty() && !data.in_todo[data.pq.top()])
 	data.pq.pop();
 
+      /* no augmenting path from start */
+      if (data.pq.empty())
+	throw std::runtime_error("lap: cost matrix is structurally singular");
+
       min = data.dist[data.pq.top()];
       while(!data.pq.empty() && data.dist[data.pq.top()] == min) {
 	const int j = data.pq.top();
-	if (data.in_todo[j]) {
-	  if (colsol[j] < 0) {
-	    endofpath = j;
-	    goto augment;
-	  }
-	  data.scan.push_back(j);
-	  data.in_todo[j] = false;
-	  data.pq.pop();
+	data.pq.pop();
+	/* columns moved to scan directly are still queued */
+	if (!data.in_todo[j])
+	  continue;
+	if (colsol[j] < 0) {
+	  endofpath = j;
+	  goto augment;
 	}
+	data.scan.push_back(j);
+	data.in_todo[j] = false;
+	data.in_scan[j] = true;
       }
     }
 
@@ -144,14 +173,16 @@ inline void augment(augmentation_data& data, const daestruct::sigma_matrix& assi
     data.is_ready[j1] = true;
 
     auto row = assigncost.findRow(i);
-    const int h = assigncost(i, j1) - v[j1];
+    const int h = rowCost(assigncost, i, j1) - v[j1];
     //sparse version of: forall j in TODO
     for (auto col = row.begin(); col != row.end() ; col++) {
       const int j = col.index2();
-      if (data.is_ready[j])
+      if (data.is_ready[j] || data.in_scan[j])
 	continue;
 
       const int c_red = *col - v[j] - h;
+      if (!data.in_todo[j])
+	data.touched.push_back(j);
       if (!data.in_todo[j] || min + c_red < data.dist[j]) {
 	data.dist[j] = min + c_red;
 	data.prev[j] = i;
@@ -161,8 +192,12 @@ inline void augment(augmentation_data& data, const daestruct::sigma_matrix& assi
 	    endofpath = j;
 	    goto augment;
 	  } else {
+	    /* its key just changed, a queued entry has to leave the heap to keep it ordered */
+	    if (data.in_todo[j])
+	      data.pq.erase(data.handles[j]);
 	    data.scan.push_back(j);
-	    data.in_todo[j] = false;	    
+	    data.in_todo[j] = false;
+	    data.in_scan[j] = true;
 	  }
 	} else {
 	  if (!data.in_todo[j]) {
@@ -205,94 +240,124 @@ std::ostream& operator<<(std::ostream& o, const solution& s) {
   return o;
 }
 
-solution delta_lap(const daestruct::sigma_matrix& assigncost, const std::vector<int>& _u, const std::vector<int>& _v,
-		   const std::vector<int>& _rowsol, const std::vector<int>& _colsol) {
-  boost::timer::auto_cpu_timer t;
+lap_workspace::lap_workspace() : data(new augmentation_data(0)) {}
+
+lap_workspace::~lap_workspace() {}
+
+void lap_workspace::reserve(int dim) {
+  free.reserve(dim);
+  matches.reserve(dim);
+  minimum_row.reserve(dim);
+  constrained.reserve(dim);
+  data->resize(dim);
+}
+
+template<typename Matrix>
+void delta_lap(const Matrix& assigncost, const std::vector<int>& _u, const std::vector<int>& _v,
+	       const std::vector<int>& _rowsol, const std::vector<int>& _colsol,
+	       lap_workspace& workspace, solution& sol) {
   const long dim = assigncost.dimension;
-  std::vector<int> u(dim),v(dim);
+  std::vector<int>& u = sol.u;
+  std::vector<int>& v = sol.v;
+  std::vector<int>& rowsol = sol.rowsol;
+  std::vector<int>& colsol = sol.colsol;
+  u.resize(dim);
+  v.resize(dim);
+  rowsol.assign(_rowsol.begin(), _rowsol.end());
+  colsol.assign(_colsol.begin(), _colsol.end());
 
   int numfree = 0;
-  int* free = new int[dim];       // list of unassigned rows.
-  int* d = new int[dim];         // 'cost-distance' in augmenting path calculation.
-  int* pred = new int[dim];       // row-predecessor of column in augmenting/alternating path.
-
-  std::vector<int> colsol(_colsol), rowsol(_rowsol); //TODO avoid this copying?
-
-  for (int j = 0; j < dim; j++) {
-    const int i = colsol[j];
-    if (i >= 0) {
-      v[j] = _v[j];
-    } else {
-      v[j] = BIG;
-      for (int i2 = 0; i2 < dim; i2++)
-	v[j] = std::min(v[j], assigncost(i2, j) - _u[i2]);
+  workspace.free.resize(dim);
+  int* free = workspace.free.data();   // list of unassigned rows.
+
+  /* unassigned columns get the largest price that keeps the assigned rows feasible,
+     one pass over the nonzeros instead of a dense column scan */
+  std::vector<bool>& constrained = workspace.constrained;
+  constrained.assign(dim, false);
+  for (int j = 0; j < dim; j++)
+    v[j] = colsol[j] >= 0 ? _v[j] : BIG;
+
+  for (auto row_it = assigncost.rowBegin(); row_it != assigncost.rowEnd(); row_it++) {
+    const int i = row_it.index1();
+    if (rowsol[i] < 0)
+      continue;
+    for (auto col_it = row_it.begin(); col_it != row_it.end(); col_it++) {
+      const int j = col_it.index2();
+      if (colsol[j] < 0 && *col_it - _u[i] < v[j]) {
+	v[j] = *col_it - _u[i];
+	constrained[j] = true;
+      }
     }
   }
 
+  /* columns only reachable from free rows are not constrained at all */
+  for (auto row_it = assigncost.rowBegin(); row_it != assigncost.rowEnd(); row_it++)
+    for (auto col_it = row_it.begin(); col_it != row_it.end(); col_it++) {
+      const int j = col_it.index2();
+      if (colsol[j] < 0 && !constrained[j] && *col_it < v[j])
+	v[j] = *col_it;
+    }
+
   for (int i = 0; i < _rowsol.size(); i++)
     if (_rowsol[i] < 0) 
       free[numfree++] = i;
 
-  /*
-  std::cout << "Running delta analysis on " << numfree << " unassigned rows" << std::endl;
-  std::cout << _rowsol << std::endl;
-  std::cout << _colsol << std::endl;
-  std::cout << u << std::endl;
-  std::cout << v << std::endl;  
-  */
-
   // AUGMENT SOLUTION for each free row.
-  augmentation_data data(assigncost.dimension);
+  augmentation_data& data = *workspace.data;
+  data.resize(dim);
   for (int f = 0; f < numfree; f++) {
     augment(data, assigncost, v, free[f], rowsol, colsol);
   }
 
   // calculate optimal cost.
-  int lapcost = 0;
+  int64_t lapcost = 0;
   for (unsigned int i = 0; i < rowsol.size(); i++) {
     const int j = rowsol[i];
-    //std::cout << "u[" << i << "] = " << "assigncost(" << i << "," << j << ") - v[" << j << "] = " <<  assigncost(i,j) << " - " << v[j] << std::endl;
-    u[i] = assigncost(i,j) - v[j];
-    lapcost = lapcost + assigncost(i,j); 
+    const int cost = rowCost(assigncost, i, j);
+    u[i] = cost - v[j];
+    lapcost = lapcost + cost;
   }
-
-  // free reserved memory.
-  delete[] pred;
-  delete[] free;
-  delete[] d;
-
-  solution sol;
-  sol.u = std::move(u);
-  sol.v = std::move(v);
-  sol.rowsol = std::move(rowsol);
-  sol.colsol = std::move(colsol);
   sol.cost = lapcost;
+}
 
-  //std::cout << "finished delta assignment" << std::endl;
+template<typename Matrix>
+solution delta_lap(const Matrix& assigncost, const std::vector<int>& _u, const std::vector<int>& _v,
+		   const std::vector<int>& _rowsol, const std::vector<int>& _colsol) {
+  lap_workspace workspace;
+  solution sol;
+  delta_lap(assigncost, _u, _v, _rowsol, _colsol, workspace, sol);
   return sol;
 }
 
-solution lap(const daestruct::sigma_matrix& assigncost) {
+template<typename Matrix>
+void lap(const Matrix& assigncost, lap_workspace& workspace, solution& sol) {
   const long dim = assigncost.dimension;
-  boost::timer::auto_cpu_timer t;
-  
-  std::vector<int> u(dim),v(dim),rowsol(dim),colsol(dim);
+
+  std::vector<int>& u = sol.u;
+  std::vector<int>& v = sol.v;
+  std::vector<int>& rowsol = sol.rowsol;
+  std::vector<int>& colsol = sol.colsol;
+  u.assign(dim, 0);
+  rowsol.assign(dim, 0);
+  colsol.assign(dim, 0);
   
-  int  i, imin, numfree = 0, prvnumfree, f, i0, k, *pred, *free;
+  int  i, imin, numfree = 0, prvnumfree, f, i0, k, *free;
   int  j, j1, j2=0, *matches;  
-  int min=0, h, umin, usubmin, *d;
+  int min=0, h, umin, usubmin;
+
+  workspace.free.resize(dim);
+  workspace.matches.assign(dim, 0);
+  free = workspace.free.data();       // list of unassigned rows.
+  matches = workspace.matches.data(); // counts how many times a row could be assigned.
 
-  free = new int[dim];      // list of unassigned rows.
-  matches = new int[dim](); // counts how many times a row could be assigned.
-  d = new int[dim];         // 'cost-distance' in augmenting path calculation.
-  pred = new int[dim];      // row-predecessor of column in augmenting/alternating path.
+  // find minimum cost over rows.
+  std::vector<int>& minimum_row = workspace.minimum_row;
+  daestruct::columnMinima(assigncost, v, minimum_row);
 
   // COLUMN REDUCTION 
   for (j = dim-1; j >= 0; j--)    // reverse order gives better results.
   {
-    // find minimum cost over rows.
-    imin = assigncost.smallest_cost_row(j);
-    v[j] = assigncost(imin,j); 
+    imin = minimum_row[j];
 
     if (++matches[imin] == 1) 
     { 
@@ -321,7 +386,9 @@ solution lap(const daestruct::sigma_matrix& assigncost) {
 	    if (*col_it - v[j] < min)
 	      min = *col_it - v[j];
 	}
-        v[j1] = v[j1] - min;
+        /* a row without other entries has nothing to transfer, lowering v[j1] by BIG would overflow later */
+        if (min < BIG)
+          v[j1] = v[j1] - min;
       }
   }
 
@@ -368,6 +435,16 @@ solution lap(const daestruct::sigma_matrix& assigncost) {
       }
 
       i0 = colsol[j1];
+      if (usubmin == BIG)
+      {
+        // single entry: the row has to take j1, lowering v[j1] by BIG would overflow later.
+        rowsol[i] = j1;
+        colsol[j1] = i;
+        if (i0 >= 0)
+          free[numfree++] = i0;
+        continue;
+      }
+
       if (umin < usubmin) 
         // change the reduction of the minimum column to increase the minimum
         // reduced cost in the row to the subminimum.
@@ -398,45 +475,158 @@ solution lap(const daestruct::sigma_matrix& assigncost) {
   }
   while (loopcnt < 2);       // repeat once.
 
-  t.report();
-  std::cout << "Done LAP initialization. " << numfree << " unassigned rows remaining." << std::endl;
-  
   // AUGMENT SOLUTION for each free row.
-  augmentation_data data(assigncost.dimension);
+  augmentation_data& data = *workspace.data;
+  data.resize(dim);
   for (f = 0; f < numfree; f++) {
     augment(data, assigncost, v, free[f], rowsol, colsol);
   }
 
   // calculate optimal cost.
-  int lapcost = 0;
+  int64_t lapcost = 0;
   for (unsigned int i = 0; i < rowsol.size(); i++) {
     j = rowsol[i];
-    u[i] = assigncost(i,j) - v[j];
-    lapcost = lapcost + assigncost(i,j); 
+    const int cost = rowCost(assigncost, i, j);
+    u[i] = cost - v[j];
+    lapcost = lapcost + cost;
   }
-
-  // free reserved memory.
-  delete[] pred;
-  delete[] free;
-  delete[] matches;
-  delete[] d;
-
-  /*
-  std::cout << "Analysis done " << std::endl;
-  std::cout << rowsol << std::endl;
-  std::cout << colsol << std::endl;
-  */
-  solution sol;
-  sol.u = std::move(u);
-  sol.v = std::move(v);
-  sol.rowsol = std::move(rowsol);
-  sol.colsol = std::move(colsol);
   sol.cost = lapcost;
+}
 
+template<typename Matrix>
+solution lap(const Matrix& assigncost) {
+  lap_workspace workspace;
+  solution sol;
+  lap(assigncost, workspace, sol);
   return sol;
 }
 
+solution dense_lap(int n, const std::vector<int>& cost) {
+  std::vector<int> rowsol(n, -1), colsol(n, -1), u(n), v(n, BIG);
+
+  // COLUMN REDUCTION, row by row over the contiguous rows.
+  for (int i = 0; i < n; i++) {
+    const int* row = &cost[static_cast<std::size_t>(i) * n];
+    for (int j = 0; j < n; j++)
+      v[j] = std::min(v[j], row[j]);
+  }
+
+  // rows take a tight free column greedily.
+  for (int i = 0; i < n; i++) {
+    const int* row = &cost[static_cast<std::size_t>(i) * n];
+    for (int j = 0; j < n; j++)
+      if (row[j] < BIG && row[j] == v[j] && colsol[j] < 0) {
+	rowsol[i] = j;
+	colsol[j] = i;
+	break;
+      }
+  }
+
+  // AUGMENT SOLUTION for each free row by a dense Dijkstra scan.
+  std::vector<int> d(n), pred(n), done(n), scanned;
+  scanned.reserve(n);
+  for (int f = 0; f < n; f++) {
+    if (rowsol[f] >= 0)
+      continue;
+
+    const int* row = &cost[static_cast<std::size_t>(f) * n];
+    for (int j = 0; j < n; j++) {
+      d[j] = row[j] < BIG ? row[j] - v[j] : BIG;
+      pred[j] = f;
+      done[j] = 0;
+    }
+    scanned.clear();
+
+    int mu, endofpath;
+    for (;;) {
+      // the minimum first (a vectorised reduction), then the first column attaining it.
+      mu = BIG;
+      for (int j = 0; j < n; j++)
+	mu = std::min(mu, done[j] ? BIG : d[j]);
+      if (mu == BIG)
+	throw std::runtime_error("lap: cost matrix is structurally singular");
+
+      int j1 = 0;
+      while (done[j1] || d[j1] != mu)
+	j1++;
+
+      done[j1] = 1;
+      scanned.push_back(j1);
+      if (colsol[j1] < 0) {
+	endofpath = j1;
+	break;
+      }
 
+      // the selects (instead of branches) let the compiler vectorise the scan of a row.
+      const int i = colsol[j1];
+      const int* irow = &cost[static_cast<std::size_t>(i) * n];
+      const int h0 = mu - (irow[j1] - v[j1]);
+      for (int j = 0; j < n; j++) {
+	const int h = irow[j] < BIG ? irow[j] - v[j] + h0 : BIG;
+	const bool better = !done[j] & (h < d[j]);
+	d[j] = better ? h : d[j];
+	pred[j] = better ? i : pred[j];
+      }
+    }
 
+    // update column prices of the scanned columns.
+    for (const int j : scanned)
+      v[j] += d[j] - mu;
+
+    int i;
+    do {
+      i = pred[endofpath];
+      colsol[endofpath] = i;
+      std::swap(endofpath, rowsol[i]);
+    } while (i != f);
+  }
+
+  int64_t lapcost = 0;
+  for (int i = 0; i < n; i++) {
+    const int c = cost[static_cast<std::size_t>(i) * n + rowsol[i]];
+    u[i] = c - v[rowsol[i]];
+    lapcost += c;
+  }
 
+  solution sol;
+  sol.cost = lapcost;
+  sol.rowsol = std::move(rowsol);
+  sol.colsol = std::move(colsol);
+  sol.u = std::move(u);
+  sol.v = std::move(v);
+  return sol;
+}
 
+template solution lap(const daestruct::sigma_matrix&);
+template solution lap(const daestruct::compact_sigma_matrix&);
+template solution lap(const daestruct::packed_sigma_matrix&);
+template solution lap(const daestruct::csr_matrix&);
+template solution lap(const daestruct::callback_matrix&);
+
+template void lap(const daestruct::sigma_matrix&, lap_workspace&, solution&);
+template void lap(const daestruct::compact_sigma_matrix&, lap_workspace&, solution&);
+template void lap(const daestruct::packed_sigma_matrix&, lap_workspace&, solution&);
+template void lap(const daestruct::csr_matrix&, lap_workspace&, solution&);
+template void lap(const daestruct::callback_matrix&, lap_workspace&, solution&);
+
+template solution delta_lap(const daestruct::sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+			    const std::vector<int>&, const std::vector<int>&);
+template solution delta_lap(const daestruct::compact_sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+			    const std::vector<int>&, const std::vector<int>&);
+template solution delta_lap(const daestruct::packed_sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+			    const std::vector<int>&, const std::vector<int>&);
+template solution delta_lap(const daestruct::csr_matrix&, const std::vector<int>&, const std::vector<int>&,
+			    const std::vector<int>&, const std::vector<int>&);
+template solution delta_lap(const daestruct::callback_matrix&, const std::vector<int>&, const std::vector<int>&,
+			    const std::vector<int>&, const std::vector<int>&);
+
+template void delta_lap(const daestruct::sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+			const std::vector<int>&, const std::vector<int>&, lap_workspace&, solution&);
+template void delta_lap(const daestruct::compact_sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+			const std::vector<int>&, const std::vector<int>&, lap_workspace&, solution&);
+template void delta_lap(const daestruct::packed_sigma_matrix&, const std::vector<int>&, const std::vector<int>&,
+			const std::vector<int>&, const std::vector<int>&, lap_workspace&, solution&);
+template void delta_lap(const daestruct::csr_matrix&, const std::vector<int>&, const std::vector<int>&,
+			const std::vector<int>&, const std::vector<int>&, lap_workspace&, solution&);
+template void delta_lap(const daestruct::callback_matrix&, const std::vector<int>&, const std::vector<int>&,
+			const std::vector<int>&, const std::vector<int>&, lap_workspace&, solution&);
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/lap_solver.hpp>
+
+#include <stdexcept>
+
+#include "lap.hpp"
+
+namespace daestruct {
+
+  struct LapSolver::Workspace {
+    csr_matrix matrix;
+
+    /* the costs relative to the smallest cost of their row */
+    std::vector<int> costs;
+    std::vector<int64_t> shift;
+
+    /* the last row a column was seen in, to find duplicate entries */
+    std::vector<int> seen;
+
+    /* the warm start handed to delta_lap() */
+    std::vector<int> u, v, rowsol, colsol;
+
+    lap_workspace buffers;
+    solution result;
+  };
+
+  LapSolver::LapSolver() : workspace(new Workspace()), total(0) {}
+
+  LapSolver::~LapSolver() {}
+
+  void LapSolver::load(int n, const int64_t* row_start, const int* columns, const int64_t* costs) {
+    if (n < 0 || (n > 0 && row_start == nullptr) || (n > 0 && row_start[0] < 0))
+      throw std::invalid_argument("lap: invalid dimension or row_start");
+
+    /* row_start[n] sizes the buffers, so all of it is checked first */
+    for (int i = 0; i < n; i++)
+      if (row_start[i + 1] < row_start[i])
+	throw std::invalid_argument("lap: row_start is not ascending");
+    if (n > 0 && row_start[n] > row_start[0] && (columns == nullptr || costs == nullptr))
+      throw std::invalid_argument("lap: missing columns or costs");
+
+    Workspace& w = *workspace;
+    w.costs.resize(n > 0 ? row_start[n] : 0);
+    w.shift.resize(n);
+    w.seen.assign(n, -1);
+
+    for (int i = 0; i < n; i++) {
+      int64_t lo = 0, hi = 0;
+      for (int64_t e = row_start[i]; e < row_start[i + 1]; e++) {
+	const int j = columns[e];
+	if (j < 0 || j >= n)
+	  throw std::invalid_argument("lap: column index out of range");
+	if (w.seen[j] == i)
+	  throw std::invalid_argument("lap: duplicate entry");
+	w.seen[j] = i;
+
+	if (e == row_start[i] || costs[e] < lo)
+	  lo = costs[e];
+	if (e == row_start[i] || costs[e] > hi)
+	  hi = costs[e];
+      }
+      /* BIG is the cost of a missing entry, the difference is computed without overflow */
+      if (row_start[i + 1] > row_start[i] && static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo) >= BIG)
+	throw std::invalid_argument("lap: the costs of a row span BIG or more");
+
+      w.shift[i] = lo;
+      for (int64_t e = row_start[i]; e < row_start[i + 1]; e++)
+	w.costs[e] = static_cast<int>(costs[e] - lo);
+    }
+
+    w.matrix = csr_matrix(n, row_start, columns, w.costs.data());
+  }
+
+  /* lap() expects an entry in every row and every column */
+  static bool coversAll(int n, const int64_t* row_start, const int* columns, std::vector<int>& seen) {
+    seen.assign(n, 0);
+    for (int i = 0; i < n; i++) {
+      if (row_start[i + 1] == row_start[i])
+	return false;
+      for (int64_t e = row_start[i]; e < row_start[i + 1]; e++)
+	seen[columns[e]] = 1;
+    }
+    for (int j = 0; j < n; j++)
+      if (!seen[j])
+	return false;
+    return true;
+  }
+
+  bool LapSolver::solve(int n, const int64_t* row_start, const int* columns, const int64_t* costs) {
+    return solve(n, row_start, columns, costs, nullptr, nullptr);
+  }
+
+  bool LapSolver::solve(int n, const int64_t* row_start, const int* columns, const int64_t* costs,
+			const int* row_assignment, const int* column_duals) {
+    load(n, row_start, columns, costs);
+    Workspace& w = *workspace;
+    const csr_matrix& matrix = w.matrix;
+
+    if (column_duals != nullptr)
+      for (int j = 0; j < n; j++)
+	if (column_duals[j] <= -BIG || column_duals[j] >= BIG)
+	  throw std::invalid_argument("lap: column dual out of range");
+
+    w.rowsol.assign(n, -1);
+    w.colsol.assign(n, -1);
+    if (row_assignment != nullptr) {
+      for (int i = 0; i < n; i++) {
+	const int j = row_assignment[i];
+	if (j < -1 || j >= n || (j >= 0 && w.colsol[j] >= 0))
+	  throw std::invalid_argument("lap: row_assignment is not a partial matching");
+	/* entries of an older model might be gone */
+	if (j >= 0 && matrix(i, j) < BIG) {
+	  w.rowsol[i] = j;
+	  w.colsol[j] = i;
+	}
+      }
+    }
+
+    w.v.assign(n, 0);
+    if (column_duals != nullptr)
+      w.v.assign(column_duals, column_duals + n);
+    else
+      for (int i = 0; i < n; i++)
+	if (w.rowsol[i] >= 0)
+	  w.v[w.rowsol[i]] = matrix(i, w.rowsol[i]);
+
+    /* without a matching, every row takes a free column of smallest reduced cost */
+    if (row_assignment == nullptr && column_duals != nullptr)
+      for (auto row_it = matrix.rowBegin(); row_it != matrix.rowEnd(); row_it++) {
+	int best = -1, reduced = 0;
+	for (auto col_it = row_it.begin(); col_it != row_it.end(); col_it++)
+	  if (best < 0 || *col_it - w.v[col_it.index2()] < reduced) {
+	    best = col_it.index2();
+	    reduced = *col_it - w.v[best];
+	  }
+	if (best >= 0 && w.colsol[best] < 0) {
+	  w.rowsol[row_it.index1()] = best;
+	  w.colsol[best] = row_it.index1();
+	}
+      }
+
+    /* a matched row has to be tight w.r.t. the other matched columns, the free ones are repriced by delta_lap() */
+    w.u.assign(n, 0);
+    for (auto row_it = matrix.rowBegin(); row_it != matrix.rowEnd(); row_it++) {
+      const int i = row_it.index1();
+      if (w.rowsol[i] < 0)
+	continue;
+
+      const int reduced = matrix(i, w.rowsol[i]) - w.v[w.rowsol[i]];
+      for (auto col_it = row_it.begin(); col_it != row_it.end(); col_it++) {
+	const int j = col_it.index2();
+	if (w.colsol[j] >= 0 && *col_it - w.v[j] < reduced) {
+	  w.colsol[w.rowsol[i]] = -1;
+	  w.rowsol[i] = -1;
+	  break;
+	}
+      }
+      if (w.rowsol[i] >= 0)
+	w.u[i] = reduced;
+    }
+
+    bool regular = coversAll(n, row_start, columns, w.seen);
+    if (regular) {
+      try {
+	if (row_assignment == nullptr && column_duals == nullptr)
+	  lap(matrix, w.buffers, w.result);
+	else
+	  delta_lap(matrix, w.u, w.v, w.rowsol, w.colsol, w.buffers, w.result);
+      } catch (const std::runtime_error&) {
+	regular = false;
+      }
+    }
+
+    if (!regular) {
+      rowsol.clear();
+      colsol.clear();
+      u.clear();
+      v.clear();
+      total = 0;
+      return false;
+    }
+
+    rowsol = w.result.rowsol;
+    colsol = w.result.colsol;
+    v = w.result.v;
+    u.resize(n);
+    total = w.result.cost;
+    for (int i = 0; i < n; i++) {
+      u[i] = w.result.u[i] + w.shift[i];
+      total += w.shift[i];
+    }
+    return true;
+  }
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "matching.hpp"
+
+#include <climits>
+#include <sstream>
+
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    int maximumMatching(const BipartiteGraph& graph, std::vector<int>& rowMatch, std::vector<int>& colMatch) {
+      const int rows = graph.rows;
+      rowMatch.assign(rows, -1);
+      colMatch.assign(graph.columns, -1);
+
+      /* cheap initial matching */
+      int size = 0;
+      for (int i = 0; i < rows; i++)
+	for (std::size_t e = graph.start[i]; e < graph.start[i + 1]; e++) {
+	  const int j = graph.adjacent[e];
+	  if (colMatch[j] < 0) {
+	    rowMatch[i] = j;
+	    colMatch[j] = i;
+	    size++;
+	    break;
+	  }
+	}
+
+      std::vector<int> layer(rows), queue(rows);
+      std::vector<std::size_t> next(rows);
+      std::vector<int> path;
+
+      for (;;) {
+	/* breadth first search from all free rows, layering the rows */
+	int head = 0, tail = 0;
+	for (int i = 0; i < rows; i++)
+	  if (rowMatch[i] < 0) {
+	    layer[i] = 0;
+	    queue[tail++] = i;
+	  } else
+	    layer[i] = INT_MAX;
+
+	bool found = false;
+	while (head < tail) {
+	  const int i = queue[head++];
+	  for (std::size_t e = graph.start[i]; e < graph.start[i + 1]; e++) {
+	    const int r = colMatch[graph.adjacent[e]];
+	    if (r < 0)
+	      found = true;
+	    else if (layer[r] == INT_MAX) {
+	      layer[r] = layer[i] + 1;
+	      queue[tail++] = r;
+	    }
+	  }
+	}
+
+	if (!found)
+	  return size;
+
+	/* vertex disjoint shortest augmenting paths by (iterative) depth first search */
+	for (int i = 0; i < rows; i++)
+	  next[i] = graph.start[i];
+
+	for (int root = 0; root < rows; root++) {
+	  if (rowMatch[root] >= 0)
+	    continue;
+
+	  path.assign(1, root);
+	  while (!path.empty()) {
+	    const int i = path.back();
+	    if (next[i] == graph.start[i + 1]) {
+	      /* dead end, never visit again in this phase */
+	      layer[i] = INT_MAX;
+	      path.pop_back();
+	      continue;
+	    }
+
+	    const int j = graph.adjacent[next[i]];
+	    const int r = colMatch[j];
+	    if (r < 0) {
+	      /* augment along the path */
+	      for (int k = path.size() - 1; k >= 0; k--) {
+		const int row = path[k];
+		const int col = graph.adjacent[next[row]];
+		rowMatch[row] = col;
+		colMatch[col] = row;
+	      }
+	      size++;
+	      path.clear();
+	    } else if (layer[r] == layer[i] + 1) {
+	      path.push_back(r);
+	    } else
+	      next[i]++;
+	  }
+	}
+      }
+    }
+
+    namespace {
+      /* mark everything reachable by alternating paths from the unmatched vertices of one side */
+      void alternatingReach(const BipartiteGraph& graph, const std::vector<int>& ownMatch, const std::vector<int>& otherMatch,
+			    std::vector<bool>& own, std::vector<bool>& other) {
+	std::vector<int> stack;
+	for (int i = 0; i < graph.rows; i++)
+	  if (ownMatch[i] < 0) {
+	    own[i] = true;
+	    stack.push_back(i);
+	  }
+
+	while (!stack.empty()) {
+	  const int i = stack.back();
+	  stack.pop_back();
+	  for (std::size_t e = graph.start[i]; e < graph.start[i + 1]; e++) {
+	    const int j = graph.adjacent[e];
+	    if (other[j])
+	      continue;
+	    other[j] = true;
+	    /* in a maximum matching, every reached vertex is matched */
+	    const int r = otherMatch[j];
+	    if (!own[r]) {
+	      own[r] = true;
+	      stack.push_back(r);
+	    }
+	  }
+	}
+      }
+
+      BipartiteGraph transpose(const BipartiteGraph& graph) {
+	BipartiteGraph t(graph.columns, graph.rows);
+	std::vector<std::size_t> count(graph.columns + 1, 0);
+	for (int j : graph.adjacent)
+	  count[j + 1]++;
+	for (int j = 0; j < graph.columns; j++)
+	  count[j + 1] += count[j];
+
+	t.start = count;
+	t.adjacent.resize(graph.adjacent.size());
+	for (int i = 0; i < graph.rows; i++)
+	  for (std::size_t e = graph.start[i]; e < graph.start[i + 1]; e++)
+	    t.adjacent[count[graph.adjacent[e]]++] = i;
+	return t;
+      }
+
+      void printList(std::ostream& o, const char* name, const std::vector<int>& list) {
+	const unsigned int shown = 20;
+	o << "\n  " << name << " (" << list.size() << "):";
+	for (unsigned int k = 0; k < list.size() && k < shown; k++)
+	  o << " " << list[k];
+	if (list.size() > shown)
+	  o << " ...";
+      }
+
+      std::string describe(const DulmageMendelsohn& dm) {
+	std::ostringstream o;
+	o << "structurally singular system, structural rank " << dm.rank << " of "
+	  << dm.over_equations.size() + dm.under_equations.size() + dm.well_equations.size();
+	printList(o, "over-determined equations", dm.over_equations);
+	printList(o, "over-determined unknowns", dm.over_variables);
+	printList(o, "under-determined equations", dm.under_equations);
+	printList(o, "under-determined unknowns", dm.under_variables);
+	printList(o, "well-determined equations", dm.well_equations);
+	printList(o, "well-determined unknowns", dm.well_variables);
+	return o.str();
+      }
+    }
+
+    DulmageMendelsohn dulmageMendelsohn(const sigma_matrix& sigma) {
+      const int n = sigma.dimension;
+      const BipartiteGraph rows = incidence(sigma, [](int, int, int) { return true; });
+
+      DulmageMendelsohn dm;
+      std::vector<int> rowMatch, colMatch;
+      dm.rank = maximumMatching(rows, rowMatch, colMatch);
+
+      std::vector<bool> overRows(n, false), overCols(n, false), underRows(n, false), underCols(n, false);
+      if (dm.rank < n) {
+	alternatingReach(rows, rowMatch, colMatch, overRows, overCols);
+	alternatingReach(transpose(rows), colMatch, rowMatch, underCols, underRows);
+      }
+
+      for (int i = 0; i < n; i++)
+	(overRows[i] ? dm.over_equations : underRows[i] ? dm.under_equations : dm.well_equations).push_back(i);
+      for (int j = 0; j < n; j++)
+	(overCols[j] ? dm.over_variables : underCols[j] ? dm.under_variables : dm.well_variables).push_back(j);
+
+      return dm;
+    }
+
+    StructurallySingular::StructurallySingular(const DulmageMendelsohn& dm) :
+      std::runtime_error(describe(dm)), decomposition(dm) {}
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_MATCHING_HPP
+#define DAE_MATCHING_HPP
+
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * Bipartite graph of rows and columns in compressed row form,
+     * the columns of row i are adjacent[start[i]] .. adjacent[start[i+1] - 1]
+     */
+    struct BipartiteGraph {
+      int rows;
+      int columns;
+      std::vector<std::size_t> start;
+      std::vector<int> adjacent;
+
+      BipartiteGraph(int r, int c) : rows(r), columns(c), start(1, 0) {}
+
+      void addEdge(int column) { adjacent.push_back(column); }
+
+      /* close the current row */
+      void endRow() { start.push_back(adjacent.size()); }
+    };
+
+    /**
+     * The graph of all entries of sigma (rows are equations, columns unknowns) accepted by keep(row, column, value)
+     */
+    template<typename Keep>
+    BipartiteGraph incidence(const sigma_matrix& sigma, Keep keep) {
+      const int n = sigma.dimension;
+      BipartiteGraph graph(n, n);
+      int i = 0;
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++) {
+	/* close rows without entries */
+	for (; i < (int)row_iter.index1(); i++)
+	  graph.endRow();
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	  if (keep(i, (int)col_iter.index2(), *col_iter))
+	    graph.addEdge(col_iter.index2());
+	graph.endRow();
+	i++;
+      }
+      for (; i < n; i++)
+	graph.endRow();
+      return graph;
+    }
+
+    /**
+     * Maximum cardinality matching (Hopcroft-Karp), unmatched rows/columns are -1.
+     * Returns the size of the matching.
+     */
+    int maximumMatching(const BipartiteGraph& graph, std::vector<int>& rowMatch, std::vector<int>& colMatch);
+
+    /**
+     * Block triangular form of a square graph w.r.t. a perfect matching (Tarjan on the
+     * row dependencies), the blocks are ordered dependencies first
+     */
+    BLT blockTriangular(const BipartiteGraph& graph, const std::vector<int>& rowMatch, const std::vector<int>& colMatch);
+  }
+}
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/partial_analysis.hpp>
+
+#include <stdexcept>
+#include <unordered_map>
+
+namespace daestruct {
+  namespace analysis {
+
+    PartialAnalysis::PartialAnalysis(const sigma_matrix& s, const std::vector<int>& row_assignment) :
+      sigma(s), assignment(row_assignment), assignedCost(s.dimension), colStart(s.dimension + 1, 0) {
+
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	  colStart[col_iter.index2() + 1]++;
+      for (int j = 0; j < sigma.dimension; j++)
+	colStart[j + 1] += colStart[j];
+
+      std::vector<int> next(colStart.begin(), colStart.end() - 1);
+      colRows.resize(colStart.back());
+      colValues.resize(colStart.back());
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  const int i = col_iter.index1(), j = col_iter.index2();
+	  if (assignment[i] == j)
+	    assignedCost[i] = *col_iter;
+	  colRows[next[j]] = i;
+	  colValues[next[j]++] = *col_iter;
+	}
+    }
+
+    PartialResult PartialAnalysis::query(const std::vector<int>& equations, const std::vector<int>& variables) const {
+      for (int i : equations)
+	if (i < 0 || i >= sigma.dimension)
+	  throw std::invalid_argument("query: equation outside the dimension");
+      for (int j : variables)
+	if (j < 0 || j >= sigma.dimension)
+	  throw std::invalid_argument("query: unknown outside the dimension");
+
+      PartialResult result;
+
+      /* closure, numbered locally in discovery order */
+      std::unordered_map<int, int> rowIndex, colIndex;
+      std::vector<int> stack;
+
+      auto addColumn = [&](int j) {
+	if (colIndex.emplace(j, result.variables.size()).second) {
+	  result.variables.push_back(j);
+	  stack.push_back(j);
+	}
+      };
+      auto addRow = [&](int i) {
+	if (rowIndex.emplace(i, result.equations.size()).second) {
+	  result.equations.push_back(i);
+	  addColumn(assignment[i]);
+	}
+      };
+
+      for (int i : equations)
+	addRow(i);
+      for (int j : variables)
+	addColumn(j);
+
+      while (!stack.empty()) {
+	const int j = stack.back();
+	stack.pop_back();
+	for (int e = colStart[j]; e < colStart[j + 1]; e++)
+	  addRow(colRows[e]);
+      }
+
+      /* the fix-point of solveByFixedPoint, restricted to the closure */
+      const unsigned int rows = result.equations.size(), cols = result.variables.size();
+      std::vector<int> assignedLocal(rows);
+      for (unsigned int k = 0; k < rows; k++)
+	assignedLocal[k] = colIndex.at(assignment[result.equations[k]]);
+
+      std::vector<int> localRows;
+      std::vector<int> localStart(1, 0);
+      for (unsigned int l = 0; l < cols; l++) {
+	const int j = result.variables[l];
+	for (int e = colStart[j]; e < colStart[j + 1]; e++)
+	  localRows.push_back(rowIndex.at(colRows[e]));
+	localStart.push_back(localRows.size());
+      }
+
+      result.c.assign(rows, 0);
+      result.d.assign(cols, 0);
+      bool converged = false;
+      while (!converged) {
+	converged = true;
+
+	for (unsigned int l = 0; l < cols; l++) {
+	  const int j = result.variables[l];
+	  for (int e = colStart[j], k = localStart[l]; e < colStart[j + 1]; e++, k++) {
+	    const int a = -colValues[e] + result.c[localRows[k]];
+	    if (a > result.d[l])
+	      result.d[l] = a;
+	  }
+	}
+
+	for (unsigned int k = 0; k < rows; k++) {
+	  const int c2 = result.d[assignedLocal[k]] + assignedCost[result.equations[k]];
+	  if (result.c[k] != c2)
+	    converged = false;
+	  result.c[k] = c2;
+	}
+      }
+
+      return result;
+    }
+  }
+}
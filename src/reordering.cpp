@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "reordering.hpp"
+
+#include <algorithm>
+
+namespace daestruct {
+  namespace analysis {
+
+    namespace {
+      /* compressed adjacency of rows (0 .. n-1) and columns (n .. 2n-1) */
+      struct Adjacency {
+	std::vector<std::size_t> start;
+	std::vector<int> adjacent;
+
+	int degree(int x) const { return start[x + 1] - start[x]; }
+      };
+
+      Adjacency adjacency(const sigma_matrix& sigma) {
+	const int n = sigma.dimension;
+	Adjacency graph;
+	graph.start.assign(2 * n + 1, 0);
+	for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	    graph.start[col_iter.index1() + 1]++;
+	    graph.start[n + col_iter.index2() + 1]++;
+	  }
+	for (int x = 0; x < 2 * n; x++)
+	  graph.start[x + 1] += graph.start[x];
+
+	std::vector<std::size_t> next(graph.start.begin(), graph.start.end() - 1);
+	graph.adjacent.resize(graph.start[2 * n]);
+	for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	    const int i = col_iter.index1(), j = n + col_iter.index2();
+	    graph.adjacent[next[i]++] = j;
+	    graph.adjacent[next[j]++] = i;
+	  }
+	return graph;
+      }
+
+      /* breadth first search from root, appends the visited nodes to order and returns the last one */
+      int bfs(const Adjacency& graph, int root, std::vector<bool>& visited, std::vector<int>& order) {
+	const int begin = order.size();
+	order.push_back(root);
+	visited[root] = true;
+
+	std::vector<int> neighbours;
+	for (unsigned int k = begin; k < order.size(); k++) {
+	  const int x = order[k];
+	  neighbours.clear();
+	  for (std::size_t e = graph.start[x]; e < graph.start[x + 1]; e++)
+	    if (!visited[graph.adjacent[e]]) {
+	      visited[graph.adjacent[e]] = true;
+	      neighbours.push_back(graph.adjacent[e]);
+	    }
+	  std::sort(neighbours.begin(), neighbours.end(),
+		    [&graph](int a, int b) { return graph.degree(a) < graph.degree(b); });
+	  order.insert(order.end(), neighbours.begin(), neighbours.end());
+	}
+	return order.back();
+      }
+    }
+
+    Reordering reverseCuthillMcKee(const sigma_matrix& sigma) {
+      const int n = sigma.dimension;
+      const Adjacency graph = adjacency(sigma);
+
+      /* rows by increasing degree are the candidate roots of the components */
+      std::vector<int> roots(n);
+      for (int i = 0; i < n; i++)
+	roots[i] = i;
+      std::stable_sort(roots.begin(), roots.end(), [&graph](int a, int b) { return graph.degree(a) < graph.degree(b); });
+
+      std::vector<bool> visited(2 * n, false), probed(2 * n, false);
+      std::vector<int> order, probe;
+      order.reserve(2 * n);
+      for (int root : roots) {
+	if (visited[root])
+	  continue;
+
+	/* one step towards a pseudo-peripheral node: restart from the end of a first search */
+	probe.clear();
+	int last = bfs(graph, root, probed, probe);
+	if (last >= n) {
+	  for (std::size_t e = graph.start[last]; e < graph.start[last + 1]; e++)
+	    last = graph.adjacent[e];
+	}
+	bfs(graph, last, visited, order);
+      }
+
+      /* columns without entries */
+      for (int j = n; j < 2 * n; j++)
+	if (!visited[j])
+	  order.push_back(j);
+
+      Reordering result;
+      result.rowPosition.resize(n);
+      result.columnPosition.resize(n);
+      for (auto x = order.rbegin(); x != order.rend(); x++) {
+	if (*x < n) {
+	  result.rowPosition[*x] = result.rows.size();
+	  result.rows.push_back(*x);
+	} else {
+	  result.columnPosition[*x - n] = result.columns.size();
+	  result.columns.push_back(*x - n);
+	}
+      }
+      return result;
+    }
+
+    sigma_matrix permute(const sigma_matrix& sigma, const Reordering& order) {
+      const int n = sigma.dimension;
+      sigma_matrix permuted(n);
+
+      std::vector<std::pair<int, int>> row;
+      for (int k = 0; k < n; k++) {
+	row.clear();
+	auto row_iter = sigma.findRow(order.rows[k]);
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	  row.push_back(std::make_pair(order.columnPosition[col_iter.index2()], *col_iter));
+
+	/* insert in column order, so ublas only appends */
+	std::sort(row.begin(), row.end());
+	for (const auto& entry : row)
+	  permuted.insert(k, entry.first, entry.second);
+      }
+      return permuted;
+    }
+
+    solution reorderedLap(const sigma_matrix& sigma) {
+      const int n = sigma.dimension;
+      const Reordering order = reverseCuthillMcKee(sigma);
+      const solution permuted = lap(permute(sigma, order));
+
+      solution result;
+      result.cost = permuted.cost;
+      result.rowsol.resize(n);
+      result.colsol.resize(n);
+      result.u.resize(n);
+      result.v.resize(n);
+      for (int i = 0; i < n; i++) {
+	result.rowsol[i] = order.columns[permuted.rowsol[order.rowPosition[i]]];
+	result.u[i] = permuted.u[order.rowPosition[i]];
+      }
+      for (int j = 0; j < n; j++) {
+	result.colsol[j] = order.rows[permuted.colsol[order.columnPosition[j]]];
+	result.v[j] = permuted.v[order.columnPosition[j]];
+      }
+      return result;
+    }
+  }
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_REORDERING_HPP
+#define DAE_REORDERING_HPP
+
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+
+#include "lap.hpp"
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * A symmetric permutation of equations and unknowns, rows[k] / columns[k] is
+     * the original index at new position k, rowPosition / columnPosition the inverse
+     */
+    struct Reordering {
+      std::vector<int> rows;
+      std::vector<int> columns;
+      std::vector<int> rowPosition;
+      std::vector<int> columnPosition;
+    };
+
+    /**
+     * Reverse Cuthill-McKee order of the bipartite graph of sigma: a breadth first
+     * search alternating between rows and columns from a pseudo-peripheral row,
+     * neighbours by increasing degree. Rows and columns that are close in the graph
+     * get close indices, which keeps the augmenting paths of the LAP local in memory.
+     */
+    Reordering reverseCuthillMcKee(const sigma_matrix& sigma);
+
+    /**
+     * sigma with rows and columns moved to their new positions
+     */
+    sigma_matrix permute(const sigma_matrix& sigma, const Reordering& order);
+
+    /**
+     * lap() in the reverse Cuthill-McKee order, the solution is mapped back to the original indices
+     */
+    solution reorderedLap(const sigma_matrix& sigma);
+  }
+}
+
+#endif
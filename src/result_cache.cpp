@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/result_cache.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <boost/filesystem.hpp>
+
+#include "binary_io.hpp"
+
+namespace fs = boost::filesystem;
+
+namespace daestruct {
+  namespace analysis {
+
+    namespace {
+      const uint32_t record_magic = 0x43525344; /* "DSRC" */
+      const uint32_t record_version = 1;
+      const char* record_suffix = ".dsr";
+
+      inline void fnv(uint64_t& h, uint32_t x) {
+	for (int k = 0; k < 4; k++) {
+	  h ^= (x >> (8*k)) & 0xff;
+	  h *= 0x100000001b3ULL;
+	}
+      }
+
+      inline void mix(uint64_t& h, uint32_t x) {
+	h ^= x + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+      }
+    }
+
+    SigmaHash::SigmaHash(const sigma_matrix& sigma) : h1(0xcbf29ce484222325ULL), h2(0x84222325cbf29ce4ULL) {
+      fnv(h1, sigma.dimension);
+      mix(h2, sigma.dimension);
+
+      /* the compressed storage iterates rows in order and columns sorted within a row */
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  fnv(h1, col_iter.index1()); fnv(h1, col_iter.index2()); fnv(h1, *col_iter);
+	  mix(h2, col_iter.index1()); mix(h2, col_iter.index2()); mix(h2, *col_iter);
+	}
+    }
+
+    std::string SigmaHash::str() const {
+      std::ostringstream s;
+      s << std::hex << std::setfill('0') << std::setw(16) << h1 << std::setw(16) << h2;
+      return s.str();
+    }
+
+    ResultCache::ResultCache(const std::string& dir, uint64_t max) : directory(dir), max_bytes(max) {
+      boost::system::error_code ec;
+      fs::create_directories(directory, ec);
+    }
+
+    std::string ResultCache::path(const SigmaHash& key) const {
+      return (fs::path(directory) / (key.str() + record_suffix)).string();
+    }
+
+    bool ResultCache::lookup(const sigma_matrix& sigma, AnalysisResult& result) const {
+      return lookup(SigmaHash(sigma), sigma, result);
+    }
+
+    bool ResultCache::lookup(const SigmaHash& key, const sigma_matrix& sigma, AnalysisResult& result) const {
+      const std::string file = path(key);
+      std::ifstream in(file, std::ios::binary);
+      if (!in)
+	return false;
+
+      uint32_t magic, version;
+      uint64_t h1, h2;
+      int64_t dimension, nnz;
+      if (!io::read(in, magic) || magic != record_magic ||
+	  !io::read(in, version) || version != record_version ||
+	  !io::read(in, h1) || !io::read(in, h2) || h1 != key.h1 || h2 != key.h2 ||
+	  !io::read(in, dimension) || dimension != sigma.dimension ||
+	  !io::read(in, nnz) || nnz != static_cast<int64_t>(sigma.nnz()))
+	return false;
+
+      /* a corrupted record must not lead to out of range indices later on */
+      const std::size_t n = sigma.dimension;
+      AnalysisResult cached;
+      if (!io::readVector(in, cached.row_assignment, n) || !io::readVector(in, cached.col_assignment, n) ||
+	  !io::readVector(in, cached.c, n) || !io::readVector(in, cached.d, n))
+	return false;
+
+      if (cached.row_assignment.size() != n || cached.col_assignment.size() != n ||
+	  cached.c.size() != n || cached.d.size() != n)
+	return false;
+      for (std::size_t i = 0; i < n; i++)
+	if (cached.row_assignment[i] < 0 || cached.row_assignment[i] >= sigma.dimension ||
+	    cached.col_assignment[cached.row_assignment[i]] != static_cast<int>(i))
+	  return false;
+
+      /* mark the record as recently used */
+      boost::system::error_code ec;
+      fs::last_write_time(file, std::time(nullptr), ec);
+
+      result = std::move(cached);
+      return true;
+    }
+
+    void ResultCache::store(const sigma_matrix& sigma, const AnalysisResult& result) const {
+      store(SigmaHash(sigma), sigma, result);
+    }
+
+    void ResultCache::store(const SigmaHash& key, const sigma_matrix& sigma, const AnalysisResult& result) const {
+      const fs::path tmp = fs::path(directory) / fs::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+
+      {
+	std::ofstream out(tmp.string(), std::ios::binary);
+	if (!out)
+	  return;
+
+	io::write(out, record_magic);
+	io::write(out, record_version);
+	io::write(out, key.h1);
+	io::write(out, key.h2);
+	io::write(out, static_cast<int64_t>(sigma.dimension));
+	io::write(out, static_cast<int64_t>(sigma.nnz()));
+	io::writeVector(out, result.row_assignment);
+	io::writeVector(out, result.col_assignment);
+	io::writeVector(out, result.c);
+	io::writeVector(out, result.d);
+
+	if (!out.flush()) {
+	  out.close();
+	  std::remove(tmp.string().c_str());
+	  return;
+	}
+      }
+
+      /* rename is atomic, readers either see the old record or the complete new one */
+      boost::system::error_code ec;
+      fs::rename(tmp, path(key), ec);
+      if (ec)
+	fs::remove(tmp, ec);
+      else
+	evict();
+    }
+
+    void ResultCache::evict() const {
+      if (max_bytes == 0)
+	return;
+
+      struct entry {
+	fs::path file;
+	std::time_t used;
+	uint64_t size;
+      };
+
+      std::vector<entry> entries;
+      uint64_t total = 0;
+      boost::system::error_code ec;
+
+      for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+	const fs::path& file = it->path();
+	if (file.extension() != record_suffix)
+	  continue;
+
+	boost::system::error_code ec2;
+	const uint64_t size = fs::file_size(file, ec2);
+	const std::time_t used = fs::last_write_time(file, ec2);
+	if (ec2)
+	  continue;
+
+	entries.push_back(entry{file, used, size});
+	total += size;
+      }
+
+      if (total <= max_bytes)
+	return;
+
+      std::sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) { return a.used < b.used; });
+
+      /* another process might evict concurrently, a failed remove is fine */
+      for (const entry& e : entries) {
+	if (total <= max_bytes)
+	  break;
+	fs::remove(e.file, ec);
+	total -= e.size;
+      }
+    }
+
+    AnalysisResult ResultCache::analyse(const InputProblem& problem) const {
+      const SigmaHash key(problem.sigma);
+      AnalysisResult result;
+      if (lookup(key, problem.sigma, result)) {
+	const int bound = problem.options.max_offset;
+	for (unsigned int i = 0; bound >= 0 && i < result.c.size() && result.bound_witness < 0; i++)
+	  if (result.c[i] > bound)
+	    result.bound_witness = i;
+	/* the record holds no BLT, it is cheap to recompute from the assignment */
+	if (problem.options.blt && result.bound_witness < 0)
+	  result.blt = bltDecomposition(problem.sigma, result);
+	return result;
+      }
+
+      result = problem.pryceAlgorithm();
+      /* a bounded analysis might be incomplete */
+      if (result.bound_witness < 0)
+	store(key, problem.sigma, result);
+      return result;
+    }
+  }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/variable_analysis.hpp>
+
+#include "binary_io.hpp"
+
+namespace daestruct {
+  namespace analysis {
+
+    using namespace boost::icl;
+
+    namespace {
+      const uint32_t session_magic = 0x4e535344; /* "DSSN" */
+      const uint32_t session_version = 1;
+
+      void writeOffsets(std::ostream& o, const interval_map<int, int>& offsets) {
+	io::write(o, static_cast<int64_t>(offsets.iterative_size()));
+	for (const auto& segment : offsets) {
+	  io::write(o, static_cast<int32_t>(segment.first.lower()));
+	  io::write(o, static_cast<int32_t>(segment.first.upper()));
+	  io::write(o, static_cast<int32_t>(segment.first.bounds().bits()));
+	  io::write(o, static_cast<int32_t>(segment.second));
+	}
+      }
+
+      bool readOffsets(std::istream& i, interval_map<int, int>& offsets) {
+	int64_t size;
+	if (!io::read(i, size) || size < 0)
+	  return false;
+
+	std::vector<int32_t> segments(4 * size);
+	if (size > 0 && !i.read(reinterpret_cast<char*>(segments.data()), segments.size() * sizeof(int32_t)).good())
+	  return false;
+
+	for (int64_t k = 0; k < size; k++) {
+	  const interval_bounds bounds(static_cast<bound_type>(segments[4*k + 2]));
+	  offsets += make_pair(discrete_interval<int>(segments[4*k], segments[4*k + 1], bounds), segments[4*k + 3]);
+	}
+	return true;
+      }
+
+      void writeResult(std::ostream& o, const AnalysisResult& result) {
+	io::writeVector(o, result.row_assignment);
+	io::writeVector(o, result.col_assignment);
+	io::writeVector(o, result.c);
+	io::writeVector(o, result.d);
+      }
+
+      void writeHeader(std::ostream& o, int dimension, int old_rows, int old_columns) {
+	io::write(o, session_magic);
+	io::write(o, session_version);
+	io::write(o, static_cast<int32_t>(dimension));
+	io::write(o, static_cast<int32_t>(old_rows));
+	io::write(o, static_cast<int32_t>(old_columns));
+      }
+    }
+
+    void saveSession(std::ostream& o, const ChangedProblem& problem, const AnalysisResult& result) {
+      writeHeader(o, problem.dimension, problem.old_rows, problem.old_columns);
+      io::writeSigma(o, problem.sigma);
+
+      io::writeVector(o, problem.row_assignment);
+      io::writeVector(o, problem.col_assignment);
+      io::writeVector(o, problem.dual_rows);
+      io::writeVector(o, problem.dual_columns);
+      io::writeVector(o, std::vector<int>(problem.row_changed.begin(), problem.row_changed.end()));
+      writeOffsets(o, problem.colOffsets);
+      writeOffsets(o, problem.rowOffsets);
+
+      writeResult(o, result);
+    }
+
+    void saveSession(std::ostream& o, const InputProblem& problem, const AnalysisResult& result) {
+      /* this is exactly the ChangedProblem of an empty change */
+      const int dimension = problem.dimension;
+      writeHeader(o, dimension, dimension, dimension);
+      io::writeSigma(o, problem.sigma);
+
+      std::vector<int> dual_columns(result.d.size());
+      for (unsigned int j = 0; j < result.d.size(); j++)
+	dual_columns[j] = -result.d[j];
+
+      io::writeVector(o, result.row_assignment);
+      io::writeVector(o, result.col_assignment);
+      io::writeVector(o, result.c);
+      io::writeVector(o, dual_columns);
+      io::writeVector(o, std::vector<int>(dimension, 0));
+      writeOffsets(o, interval_map<int, int>());
+      writeOffsets(o, interval_map<int, int>());
+
+      writeResult(o, result);
+    }
+
+    std::unique_ptr<ChangedProblem> restoreSession(std::istream& i, AnalysisResult& result) {
+      uint32_t magic, version;
+      int32_t dimension, old_rows, old_columns;
+      if (!io::read(i, magic) || magic != session_magic ||
+	  !io::read(i, version) || version != session_version ||
+	  !io::read(i, dimension) || !io::read(i, old_rows) || !io::read(i, old_columns) || dimension < 0 ||
+	  old_rows < 0 || old_rows > dimension || old_columns < 0 || old_columns > dimension)
+	return std::unique_ptr<ChangedProblem>();
+
+      std::unique_ptr<ChangedProblem> problem(new ChangedProblem(dimension));
+      problem->old_rows = old_rows;
+      problem->old_columns = old_columns;
+
+      std::vector<int> row_changed;
+      AnalysisResult restored;
+      if (!io::readSigma(i, problem->sigma) ||
+	  !io::readVector(i, problem->row_assignment, dimension) || !io::readVector(i, problem->col_assignment, dimension) ||
+	  !io::readVector(i, problem->dual_rows, dimension) || !io::readVector(i, problem->dual_columns, dimension) ||
+	  !io::readVector(i, row_changed, dimension) ||
+	  !readOffsets(i, problem->colOffsets) || !readOffsets(i, problem->rowOffsets) ||
+	  !io::readVector(i, restored.row_assignment, dimension) || !io::readVector(i, restored.col_assignment, dimension) ||
+	  !io::readVector(i, restored.c, dimension) || !io::readVector(i, restored.d, dimension))
+	return std::unique_ptr<ChangedProblem>();
+
+      /* a truncated or corrupted file must not lead to out of range indices later on */
+      const unsigned int dim = dimension;
+      if (problem->row_assignment.size() != dim || problem->col_assignment.size() != dim ||
+	  problem->dual_rows.size() != dim || problem->dual_columns.size() != dim || row_changed.size() != dim ||
+	  restored.row_assignment.size() != dim || restored.col_assignment.size() != dim ||
+	  restored.c.size() != dim || restored.d.size() != dim)
+	return std::unique_ptr<ChangedProblem>();
+
+      /* the old assignment may be partial (-1), the result is a perfect matching */
+      for (int k = 0; k < dimension; k++) {
+	const int j = problem->row_assignment[k], r = problem->col_assignment[k];
+	if (j < -1 || j >= dimension || r < -1 || r >= dimension)
+	  return std::unique_ptr<ChangedProblem>();
+	const int rj = restored.row_assignment[k];
+	if (rj < 0 || rj >= dimension || restored.col_assignment[rj] != k)
+	  return std::unique_ptr<ChangedProblem>();
+      }
+
+      problem->row_changed.assign(row_changed.begin(), row_changed.end());
+      result = std::move(restored);
+      return problem;
+    }
+  }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/solution_scheme.hpp>
+
+#include <algorithm>
+
+namespace daestruct {
+  namespace analysis {
+
+    namespace {
+      /* counting sort of the indices by decreasing offset, count[s] = number of offsets >= stages - 1 - s */
+      void bucket(const std::vector<int>& offset, int stages, std::vector<int>& sorted, std::vector<int>& count) {
+	count.assign(stages, 0);
+	for (int o : offset)
+	  count[stages - 1 - o]++;
+	for (int s = 1; s < stages; s++)
+	  count[s] += count[s - 1];
+
+	/* fill every bucket from its start */
+	std::vector<int> next(stages, 0);
+	for (int s = 1; s < stages; s++)
+	  next[s] = count[s - 1];
+
+	sorted.resize(offset.size());
+	for (unsigned int i = 0; i < offset.size(); i++)
+	  sorted[next[stages - 1 - offset[i]]++] = i;
+      }
+    }
+
+    SolutionScheme solutionScheme(const AnalysisResult& result) {
+      SolutionScheme scheme;
+      const int max_d = result.d.empty() ? 0 : *std::max_element(result.d.begin(), result.d.end());
+      scheme.first_stage = -max_d;
+
+      /* stage k = first_stage + s activates offsets >= -k = max_d - s, c <= max(d) for the canonical offsets */
+      bucket(result.c, max_d + 1, scheme.equations, scheme.equation_count);
+      bucket(result.d, max_d + 1, scheme.variables, scheme.variable_count);
+
+      scheme.dof = 0;
+      for (int dj : result.d)
+	scheme.dof += dj;
+      for (int ci : result.c)
+	scheme.dof -= ci;
+
+      return scheme;
+    }
+  }
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "symmetry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+#include "warm_start.hpp"
+
+namespace daestruct {
+  namespace analysis {
+
+    namespace {
+      typedef ComponentTemplate::Entry Entry;
+
+      /* rows and columns of a component, its entries in local (position) indices */
+      struct Component {
+	std::vector<int> rows;
+	std::vector<int> columns;
+	std::vector<Entry> entries;
+	uint64_t hash;
+      };
+
+      int find(std::vector<int>& parent, int x) {
+	while (parent[x] != x)
+	  x = parent[x] = parent[parent[x]];
+	return x;
+      }
+
+      inline void mix(uint64_t& h, uint32_t x) {
+	h ^= x + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+      }
+
+      /* equal up to the index shift of rows and columns */
+      bool isomorphic(const Component& a, const Component& b) {
+	if (a.hash != b.hash || a.rows.size() != b.rows.size() || a.columns.size() != b.columns.size() ||
+	    a.entries.size() != b.entries.size())
+	  return false;
+
+	const int dr = b.rows[0] - a.rows[0], dc = b.columns[0] - a.columns[0];
+	for (unsigned int k = 0; k < a.rows.size(); k++)
+	  if (b.rows[k] - a.rows[k] != dr)
+	    return false;
+	for (unsigned int k = 0; k < a.columns.size(); k++)
+	  if (b.columns[k] - a.columns[k] != dc)
+	    return false;
+	for (unsigned int k = 0; k < a.entries.size(); k++)
+	  if (a.entries[k].equation != b.entries[k].equation || a.entries[k].variable != b.entries[k].variable ||
+	      a.entries[k].derivative != b.entries[k].derivative)
+	    return false;
+	return true;
+      }
+    }
+
+    bool symmetricAssignment(const sigma_matrix& sigma, AnalysisResult& result) {
+      const int n = sigma.dimension;
+      if (n == 0)
+	return false;
+
+      std::vector<int> rowDegree(n, 0), colDegree(n, 0);
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  rowDegree[col_iter.index1()]++;
+	  colDegree[col_iter.index2()]++;
+	}
+
+      const int hub = std::max(8, static_cast<int>(std::sqrt(static_cast<double>(sigma.nnz()))));
+
+      /* rows are nodes 0 .. n-1, columns n .. 2n-1 */
+      std::vector<int> parent(2 * n);
+      for (int x = 0; x < 2 * n; x++)
+	parent[x] = x;
+
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++) {
+	const int i = row_iter.index1();
+	if (rowDegree[i] > hub)
+	  continue;
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  const int j = col_iter.index2();
+	  if (colDegree[j] <= hub)
+	    parent[find(parent, i)] = find(parent, n + j);
+	}
+      }
+
+      std::vector<int> componentOf(2 * n, -1), position(2 * n);
+      std::vector<Component> components;
+      for (int x = 0; x < 2 * n; x++) {
+	if (x < n ? rowDegree[x] > hub : colDegree[x - n] > hub)
+	  continue;
+	const int root = find(parent, x);
+	if (componentOf[root] < 0) {
+	  componentOf[root] = components.size();
+	  components.push_back(Component());
+	}
+	Component& component = components[componentOf[root]];
+	componentOf[x] = componentOf[root];
+	std::vector<int>& members = x < n ? component.rows : component.columns;
+	position[x] = members.size();
+	members.push_back(x < n ? x : x - n);
+      }
+
+      /* rows are visited in order and columns sorted, so the local entries come out sorted */
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++) {
+	const int i = row_iter.index1();
+	if (rowDegree[i] > hub)
+	  continue;
+	Component& component = components[componentOf[i]];
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  const int j = col_iter.index2();
+	  if (colDegree[j] <= hub)
+	    component.entries.push_back(Entry{position[i], position[n + j], -*col_iter});
+	}
+      }
+
+      /* group by hash, the representative of a class is its first member */
+      std::unordered_map<uint64_t, std::vector<int>> byHash;
+      std::vector<int> representative(components.size(), -1);
+      std::vector<int> classSize(components.size(), 0);
+      for (unsigned int k = 0; k < components.size(); k++) {
+	Component& component = components[k];
+	if (component.rows.empty() || component.columns.empty())
+	  continue;
+
+	uint64_t h = 0xcbf29ce484222325ULL;
+	mix(h, component.rows.size());
+	mix(h, component.columns.size());
+	for (const Entry& e : component.entries) {
+	  mix(h, e.equation); mix(h, e.variable); mix(h, e.derivative);
+	}
+	component.hash = h;
+
+	std::vector<int>& candidates = byHash[h];
+	for (int c : candidates)
+	  if (isomorphic(components[c], component)) {
+	    representative[k] = c;
+	    break;
+	  }
+	if (representative[k] < 0) {
+	  representative[k] = k;
+	  candidates.push_back(k);
+	}
+	classSize[representative[k]]++;
+      }
+
+      /* the padded local problems are dense in their unassigned block, keep them small */
+      auto replicated = [&](int k) {
+	const Component& r = components[representative[k]];
+	return classSize[representative[k]] > 1 &&
+	  static_cast<long>(r.rows.size() * r.columns.size()) <= static_cast<long>(sigma.nnz());
+      };
+
+      long replicatedRows = 0;
+      for (unsigned int k = 0; k < components.size(); k++)
+	if (representative[k] >= 0 && replicated(k))
+	  replicatedRows += components[k].rows.size();
+      if (2 * replicatedRows < n)
+	return false;
+
+      std::unordered_map<int, LocalSolution> solutions;
+      std::vector<int> rowsol(n, -1), colsol(n, -1), v(n, 0);
+      for (unsigned int k = 0; k < components.size(); k++) {
+	if (representative[k] < 0 || !replicated(k))
+	  continue;
+
+	const Component& r = components[representative[k]];
+	auto cached = solutions.find(representative[k]);
+	if (cached == solutions.end())
+	  cached = solutions.emplace(representative[k], solveLocal(r.rows.size(), r.columns.size(), r.entries)).first;
+	const LocalSolution& local = cached->second;
+
+	const Component& component = components[k];
+	for (unsigned int t = 0; t < component.rows.size(); t++)
+	  if (local.rowsol[t] >= 0) {
+	    const int i = component.rows[t], j = component.columns[local.rowsol[t]];
+	    rowsol[i] = j;
+	    colsol[j] = i;
+	  }
+	for (unsigned int s = 0; s < component.columns.size(); s++)
+	  v[component.columns[s]] = local.v[s];
+      }
+
+      completeAssignment(sigma, rowsol, colsol, v, result);
+      result.stats.replicated_rows = replicatedRows;
+      return true;
+    }
+  }
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_SYMMETRY_HPP
+#define DAE_SYMMETRY_HPP
+
+#include <daestruct/sigma_matrix.hpp>
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * Assignment of a flattened model with replicated sub-structures.
+     *
+     * Rows and columns of high degree (buses, sums over all sub-models) are taken
+     * as coupling, the rest of the incidence graph falls apart into connected
+     * components. Components whose entries coincide up to an index shift are
+     * detected by hashing their shifted entries, the LAP of one representative
+     * per class is solved and its assignment and column prices are shifted to
+     * all other members. Only the coupling rows (and the rows violating the
+     * replicated prices) are left to the augmentation.
+     *
+     * Returns false, without touching result, if less than half of the rows
+     * are replicated.
+     */
+    bool symmetricAssignment(const sigma_matrix& sigma, AnalysisResult& result);
+  }
+}
+
+#endif
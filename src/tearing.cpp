@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/tearing.hpp>
+
+#include <queue>
+#include <utility>
+
+#include "matching.hpp"
+
+namespace daestruct {
+  namespace analysis {
+
+    Tearing tearing(const sigma_matrix& sigma, const AnalysisResult& result) {
+      const int n = sigma.dimension;
+      const std::vector<int>& c = result.c;
+      const std::vector<int>& d = result.d;
+      const BLT& blt = result.blt;
+
+      const BipartiteGraph jacobian = incidence(sigma, [&](int i, int j, int value) { return -value == d[j] - c[i]; });
+
+      /* block of every variable, everything outside the current block is known */
+      std::vector<int> blockOf(n);
+      for (int b = 0; b < blt.blocks(); b++)
+	for (int k = blt.block_start[b]; k < blt.block_start[b + 1]; k++)
+	  blockOf[blt.variables[k]] = b;
+
+      Tearing tearing;
+      tearing.tear_start.push_back(0);
+      tearing.order_start.push_back(0);
+
+      std::vector<int> unknowns(n), occurrences(n);
+      std::vector<bool> known(n), done(n);
+      std::vector<int> local(n), colRows;
+
+      for (int b = 0; b < blt.blocks(); b++) {
+	const int begin = blt.block_start[b], end = blt.block_start[b + 1];
+
+	if (end - begin == 1) {
+	  tearing.equations.push_back(blt.equations[begin]);
+	  tearing.variables.push_back(blt.variables[begin]);
+	  tearing.tear_start.push_back(tearing.tears.size());
+	  tearing.order_start.push_back(tearing.equations.size());
+	  continue;
+	}
+
+	for (int k = begin; k < end; k++) {
+	  known[blt.variables[k]] = false;
+	  occurrences[blt.variables[k]] = 0;
+	}
+
+	std::vector<std::pair<int, int>> entries;
+	for (int k = begin; k < end; k++) {
+	  const int i = blt.equations[k];
+	  done[i] = false;
+	  unknowns[i] = 0;
+	  for (std::size_t e = jacobian.start[i]; e < jacobian.start[i + 1]; e++) {
+	    const int j = jacobian.adjacent[e];
+	    if (blockOf[j] == b) {
+	      unknowns[i]++;
+	      occurrences[j]++;
+	      entries.push_back(std::make_pair(j, i));
+	    }
+	  }
+	}
+
+	/* local column lists, indexed by position of the variable in the block */
+	std::vector<int> colStart(end - begin + 1, 0);
+	for (int k = begin; k < end; k++)
+	  local[blt.variables[k]] = k - begin;
+	for (const auto& entry : entries)
+	  colStart[local[entry.first] + 1]++;
+	for (int k = 0; k < end - begin; k++)
+	  colStart[k + 1] += colStart[k];
+	colRows.resize(entries.size());
+	{
+	  std::vector<int> next(colStart.begin(), colStart.end() - 1);
+	  for (const auto& entry : entries)
+	    colRows[next[local[entry.first]]++] = entry.second;
+	}
+
+	std::vector<int> ready;
+	for (int k = begin; k < end; k++)
+	  if (unknowns[blt.equations[k]] == 1)
+	    ready.push_back(blt.equations[k]);
+
+	/* tear candidates by occurrences, stale entries are skipped */
+	std::priority_queue<std::pair<int, int>> candidates;
+	for (int k = begin; k < end; k++)
+	  candidates.push(std::make_pair(occurrences[blt.variables[k]], -blt.variables[k]));
+
+	/* a variable became known: update the equations containing it */
+	auto learn = [&](int j) {
+	  known[j] = true;
+	  for (int e = colStart[local[j]]; e < colStart[local[j] + 1]; e++) {
+	    const int i = colRows[e];
+	    if (done[i])
+	      continue;
+	    if (--unknowns[i] == 1)
+	      ready.push_back(i);
+	    else if (unknowns[i] == 0) {
+	      /* all unknowns are determined otherwise */
+	      done[i] = true;
+	      tearing.residuals.push_back(i);
+	    }
+	  }
+	};
+
+	/* an equation was solved or became a residual */
+	auto retire = [&](int i) {
+	  for (std::size_t e = jacobian.start[i]; e < jacobian.start[i + 1]; e++) {
+	    const int j = jacobian.adjacent[e];
+	    if (blockOf[j] == b && !known[j]) {
+	      occurrences[j]--;
+	      candidates.push(std::make_pair(occurrences[j], -j));
+	    }
+	  }
+	};
+
+	int solved = 0;
+	while (solved < end - begin) {
+	  /* residuals have no unknowns left, they do not need to be retired */
+	  if (!ready.empty()) {
+	    const int i = ready.back();
+	    ready.pop_back();
+	    if (done[i] || unknowns[i] != 1)
+	      continue;
+
+	    int variable = -1;
+	    for (std::size_t e = jacobian.start[i]; e < jacobian.start[i + 1] && variable < 0; e++) {
+	      const int j = jacobian.adjacent[e];
+	      if (blockOf[j] == b && !known[j])
+		variable = j;
+	    }
+
+	    done[i] = true;
+	    retire(i);
+	    tearing.equations.push_back(i);
+	    tearing.variables.push_back(variable);
+	    learn(variable);
+	    solved++;
+	    continue;
+	  }
+
+	  /* no causal equation left, tear */
+	  std::pair<int, int> top = candidates.top();
+	  candidates.pop();
+	  const int j = -top.second;
+	  if (known[j] || top.first != occurrences[j])
+	    continue;
+
+	  tearing.tears.push_back(j);
+	  learn(j);
+	  solved++;
+	}
+
+	tearing.tear_start.push_back(tearing.tears.size());
+	tearing.order_start.push_back(tearing.equations.size());
+      }
+
+      return tearing;
+    }
+  }
+}
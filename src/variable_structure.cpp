@@ -19,6 +19,9 @@
 
 #include <daestruct.h>
 #include <daestruct/variable_structure.h>
+
+#include <fstream>
+#include <iostream>
   
 #include <daestruct/analysis.hpp>
 #include <daestruct/variable_analysis.hpp>
@@ -96,6 +99,34 @@ extern "C" {
   }
 
   struct daestruct_result* daestruct_changed_analyse(struct daestruct_changed* problem) {
-    return static_cast<daestruct_result*>(new AnalysisResult(problem->pryceAlgorithm()));
+    try {
+      return static_cast<daestruct_result*>(new AnalysisResult(problem->pryceAlgorithm()));
+    } catch (const std::runtime_error& e) {
+      std::cerr << e.what() << std::endl;
+      return nullptr;
+    }
+  }
+
+  int daestruct_session_save(const char* file, struct daestruct_changed* problem, struct daestruct_result* result) {
+    std::ofstream out(file, std::ios::binary);
+    saveSession(out, *problem, *result);
+    return out.flush() ? 0 : -1;
+  }
+
+  int daestruct_session_save_orig(const char* file, struct daestruct_input* problem, struct daestruct_result* result) {
+    std::ofstream out(file, std::ios::binary);
+    saveSession(out, *problem, *result);
+    return out.flush() ? 0 : -1;
+  }
+
+  struct daestruct_changed* daestruct_session_restore(const char* file, struct daestruct_result** result) {
+    std::ifstream in(file, std::ios::binary);
+    AnalysisResult restored;
+    std::unique_ptr<ChangedProblem> problem = restoreSession(in, restored);
+    if (!problem)
+      return nullptr;
+
+    *result = static_cast<daestruct_result*>(new AnalysisResult(std::move(restored)));
+    return static_cast<daestruct_changed*>(problem.release());
   }
 }
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "warm_start.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "lap.hpp"
+
+namespace daestruct {
+  namespace analysis {
+
+    LocalSolution solveLocal(int eqs, int vars, const std::vector<ComponentTemplate::Entry>& entries) {
+      sigma_matrix padded(eqs + vars);
+      auto entry = entries.begin();
+      for (int i = 0; i < eqs; i++) {
+	for (; entry != entries.end() && entry->equation == i; entry++)
+	  padded.insert(i, entry->variable, -entry->derivative);
+	padded.insert(i, vars + i, 1);
+      }
+      for (int j = 0; j < vars; j++) {
+	padded.insert(eqs + j, j, 1);
+	for (int i = 0; i < eqs; i++)
+	  padded.insert(eqs + j, vars + i, 0);
+      }
+
+      LocalSolution local;
+      local.rowsol.assign(eqs, -1);
+      local.u.assign(eqs, 0);
+      local.v.assign(vars, 0);
+      if (eqs + vars == 0)
+	return local;
+
+      const solution padded_solution = lap(padded);
+      for (int i = 0; i < eqs; i++) {
+	const int j = padded_solution.rowsol[i];
+	local.rowsol[i] = j < vars ? j : -1;
+	local.u[i] = padded_solution.u[i];
+      }
+      for (int j = 0; j < vars; j++)
+	local.v[j] = padded_solution.v[j];
+
+      return local;
+    }
+
+    void completeAssignment(const sigma_matrix& sigma, std::vector<int>& rowsol, std::vector<int>& colsol,
+			    std::vector<int>& v, AnalysisResult& result) {
+      std::vector<int> u(sigma.dimension, 0);
+
+      /* interface or coupling entries might violate the local duals, such rows are left to the augmentation */
+      for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++) {
+	const int i = row_iter.index1();
+	if (rowsol[i] < 0)
+	  continue;
+
+	u[i] = sigma(i, rowsol[i]) - v[rowsol[i]];
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	  const int j = col_iter.index2();
+	  if (colsol[j] >= 0 && *col_iter - v[j] < u[i]) {
+	    colsol[rowsol[i]] = -1;
+	    rowsol[i] = -1;
+	    break;
+	  }
+	}
+      }
+
+      result.stats.lap_dimension = std::count(rowsol.begin(), rowsol.end(), -1);
+
+      try {
+	solution assignment = delta_lap(sigma, u, v, rowsol, colsol);
+	result.row_assignment = std::move(assignment.rowsol);
+	result.col_assignment = std::move(assignment.colsol);
+      } catch (const std::runtime_error&) {
+	throw StructurallySingular(dulmageMendelsohn(sigma));
+      }
+    }
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAE_WARM_START_HPP
+#define DAE_WARM_START_HPP
+
+#include <vector>
+
+#include <daestruct/sigma_matrix.hpp>
+#include <daestruct/analysis.hpp>
+#include <daestruct/composite.hpp>
+
+namespace daestruct {
+  namespace analysis {
+
+    /**
+     * optimal (partial) assignment of a local problem with its duals
+     */
+    struct LocalSolution {
+      std::vector<int> rowsol;
+      std::vector<int> u;
+      std::vector<int> v;
+    };
+
+    /**
+     * Solve a local eqs x vars problem, padded to a square one: equation i may stay
+     * unassigned (column vars + i) as may variable j (row eqs + j), both at a cost
+     * worse than any real entry, unassigned pairs match each other for free.
+     * entries must be sorted by position and free of duplicates.
+     */
+    LocalSolution solveLocal(int eqs, int vars, const std::vector<ComponentTemplate::Entry>& entries);
+
+    /**
+     * Complete a partial assignment with dual prices v of the assigned columns by delta_lap.
+     * Rows whose entries violate these prices are freed first. Fills the assignment of result
+     * and the number of augmented rows, throws StructurallySingular.
+     */
+    void completeAssignment(const sigma_matrix& sigma, std::vector<int>& rowsol, std::vector<int>& colsol,
+			    std::vector<int>& v, AnalysisResult& result);
+  }
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis.hpp>
+#include <daestruct/analysis_plan.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <random>
+#include <prettyprint.hpp>
+
+#include "analysisPlanTests.hpp"
+#include "eliminationTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    /* the problem of the plan with the given derivatives */
+    static InputProblem planned(const sigma_matrix& pattern, const AnalysisPlan& plan, const std::vector<int>& derivatives) {
+      InputProblem p(pattern.dimension);
+      for (auto row_iter = pattern.rowBegin(); row_iter != pattern.rowEnd(); row_iter++)
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	  p.sigma.insert(col_iter.index1(), col_iter.index2(),
+			 -derivatives[plan.position(col_iter.index1(), col_iter.index2())]);
+      return p;
+    }
+
+    void test_plan_pendulum_variants() {
+      /* x^2 + y^2 = L^2, der(x) = vx, der(y) = vy, der(vx) = F x, der(vy) = F y - g */
+      InputProblem pendulum(5);
+      pendulum.sigma.insert(0, 0, 0); pendulum.sigma.insert(0, 1, 0);
+      pendulum.sigma.insert(1, 0, -1); pendulum.sigma.insert(1, 2, 0);
+      pendulum.sigma.insert(2, 1, -1); pendulum.sigma.insert(2, 3, 0);
+      pendulum.sigma.insert(3, 0, 0); pendulum.sigma.insert(3, 2, -1); pendulum.sigma.insert(3, 4, 0);
+      pendulum.sigma.insert(4, 1, 0); pendulum.sigma.insert(4, 3, -1); pendulum.sigma.insert(4, 4, 0);
+
+      const AnalysisPlan plan(pendulum.sigma);
+      BOOST_CHECK_EQUAL( plan.dimension(), 5 );
+      BOOST_CHECK_EQUAL( plan.nnz(), 12 );
+      BOOST_CHECK_EQUAL( plan.position(0, 2), -1 );
+
+      std::vector<int> derivatives = plan.values(pendulum.sigma);
+      const AnalysisResult res = plan.execute(derivatives);
+      BOOST_CHECK_EQUAL( res.c, std::vector<int>({2, 1, 1, 0, 0}) );
+      BOOST_CHECK_EQUAL( res.d, std::vector<int>({2, 2, 1, 1, 0}) );
+
+      /* move der() from the velocities to the positions */
+      derivatives[plan.position(1, 0)] = 0;
+      derivatives[plan.position(1, 2)] = 1;
+      derivatives[plan.position(2, 1)] = 0;
+      derivatives[plan.position(2, 3)] = 1;
+
+      AnalysisPlan::Workspace workspace(plan);
+      const AnalysisResult variant = plan.execute(derivatives, workspace);
+      const AnalysisResult expected = planned(pendulum.sigma, plan, derivatives).pryceAlgorithm();
+      BOOST_CHECK_EQUAL( variant.c, expected.c );
+      BOOST_CHECK_EQUAL( variant.d, expected.d );
+    }
+
+    void test_plan_random_values() {
+      for (unsigned int seed = 0; seed < 20; seed++) {
+	const int n = 30 + seed;
+	InputProblem pattern(n);
+	setRandomIncidence(pattern, seed, 1 + seed % 3, 0);
+
+	const AnalysisPlan plan(pattern.sigma);
+	AnalysisPlan::Workspace workspace(plan);
+
+	mt19937 gen(seed);
+	uniform_int_distribution<int> der(0, 3);
+	for (int variant = 0; variant < 5; variant++) {
+	  std::vector<int> derivatives(plan.nnz());
+	  for (int& value : derivatives)
+	    value = der(gen);
+
+	  const AnalysisResult res = plan.execute(derivatives, workspace);
+	  const AnalysisResult expected = planned(pattern.sigma, plan, derivatives).pryceAlgorithm();
+	  BOOST_CHECK_EQUAL( res.c, expected.c );
+	  BOOST_CHECK_EQUAL( res.d, expected.d );
+	}
+      }
+    }
+  }
+}
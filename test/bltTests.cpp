@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct.h>
+#include <daestruct/analysis.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <prettyprint.hpp>
+
+#include "circuitAnalysis.hpp"
+#include "eliminationTests.hpp"
+#include "bltTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    /**
+     * every Jacobian entry refers to a variable of the same or an earlier block
+     */
+    void checkBLT(const InputProblem& p, const AnalysisResult& res) {
+      const int n = p.dimension;
+      const BLT& blt = res.blt;
+      BOOST_REQUIRE_EQUAL( blt.equations.size(), (unsigned int)n );
+      BOOST_REQUIRE_EQUAL( blt.block_start.back(), n );
+
+      std::vector<int> blockOf(n, -1);
+      for (int b = 0; b < blt.blocks(); b++)
+	for (int k = blt.block_start[b]; k < blt.block_start[b + 1]; k++) {
+	  BOOST_CHECK_EQUAL( res.row_assignment[blt.equations[k]], blt.variables[k] );
+	  blockOf[blt.variables[k]] = b;
+	}
+
+      for (int b = 0; b < blt.blocks(); b++)
+	for (int k = blt.block_start[b]; k < blt.block_start[b + 1]; k++) {
+	  const int i = blt.equations[k];
+	  auto row_iter = p.sigma.findRow(i);
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	    const int j = col_iter.index2();
+	    if (-*col_iter == res.d[j] - res.c[i])
+	      BOOST_CHECK( blockOf[j] <= b );
+	  }
+	}
+    }
+
+    void test_blt_triangular() {
+      /*
+       * x = 1
+       * y = x
+       * z + w = y
+       * z - w = 0
+       */
+      InputProblem p(4);
+      p.sigma.insert(0, 0, 0);
+      p.sigma.insert(1, 0, 0);
+      p.sigma.insert(1, 1, 0);
+      p.sigma.insert(2, 1, 0);
+      p.sigma.insert(2, 2, 0);
+      p.sigma.insert(2, 3, 0);
+      p.sigma.insert(3, 2, 0);
+      p.sigma.insert(3, 3, 0);
+      p.options.blt = true;
+
+      const AnalysisResult res = p.pryceAlgorithm();
+      BOOST_CHECK_EQUAL( res.blt.blocks(), 3 );
+      BOOST_CHECK_EQUAL( res.blt.block_start, std::vector<int>({0, 1, 2, 4}) );
+      BOOST_CHECK_EQUAL( res.blt.equations[0], 0 );
+      BOOST_CHECK_EQUAL( res.blt.equations[1], 1 );
+      BOOST_CHECK_EQUAL( res.blt.blockSize(2), 2 );
+      checkBLT(p, res);
+    }
+
+    void test_blt_pendulum() {
+      struct daestruct_input* pendulum = daestruct_input_create(3);
+      daestruct_input_set(pendulum, 0, 0, 0);
+      daestruct_input_set(pendulum, 1, 0, 0);
+      daestruct_input_set(pendulum, 0, 1, 2);
+      daestruct_input_set(pendulum, 2, 1, 0);
+      daestruct_input_set(pendulum, 1, 2, 2);
+      daestruct_input_set(pendulum, 2, 2, 0);
+      daestruct_input_enable_blt(pendulum, 1);
+
+      struct daestruct_result* res = daestruct_analyse(pendulum);
+      BOOST_CHECK_EQUAL( daestruct_result_blt_blocks(res), 1 );
+      BOOST_CHECK_EQUAL( daestruct_result_blt_block_start(res)[1], 3 );
+
+      daestruct_result_delete(res);
+      daestruct_input_delete(pendulum);
+    }
+
+    void test_blt_random() {
+      InputProblem circuit(10);
+      setCircuitIncidence(circuit);
+      circuit.options.blt = true;
+      checkBLT(circuit, circuit.pryceAlgorithm());
+
+      for (unsigned int seed = 0; seed < 100; seed++) {
+	InputProblem p(1 + seed % 40);
+	setRandomIncidence(p, seed, 1 + seed % 2, 2);
+	p.options.blt = true;
+	checkBLT(p, p.pryceAlgorithm());
+      }
+    }
+  }
+}
@@ -28,6 +28,23 @@ extern int putenv(char*);
 #include "pendulumAnalysis.hpp"
 #include "circuitAnalysis.hpp"
 #include "test_lap.hpp"
+#include "resultCache.hpp"
+#include "sessionTests.hpp"
+#include "eliminationTests.hpp"
+#include "fastPathTests.hpp"
+#include "singularityTests.hpp"
+#include "partialAnalysisTests.hpp"
+#include "bltTests.hpp"
+#include "differentiatedSystemTests.hpp"
+#include "solutionSchemeTests.hpp"
+#include "dummyDerivativeTests.hpp"
+#include "tearingTests.hpp"
+#include "compositeTests.hpp"
+#include "symmetryTests.hpp"
+#include "analysisPlanTests.hpp"
+#include "reorderingTests.hpp"
+#include "denseTests.hpp"
+#include "lapSolverTests.hpp"
 
 using namespace boost::unit_test;
 
@@ -41,6 +58,9 @@ init_unit_test_suite( int argc, char* argv[] ) {
   framework::master_test_suite().
         add( BOOST_TEST_CASE( &test_LAP_delta ) );
 
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_LAP_delta_changed_problem ) );
+
   framework::master_test_suite().
         add( BOOST_TEST_CASE( &test_LAP_better_delta ) );
   
@@ -50,14 +70,160 @@ init_unit_test_suite( int argc, char* argv[] ) {
   framework::master_test_suite().
         add( BOOST_TEST_CASE( &test_LAP_on_identity ) );
 
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_LAP_dual_feasible ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_LAP_scanned_columns ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_LAP_compact ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_LAP_packed ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_LAP_cost_overflow ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_LAP_dense ) );
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_LAP_row_matrices ) );
+
   framework::master_test_suite().
         add( BOOST_TEST_CASE( &analyzePendulum ) );
 
   framework::master_test_suite().
         add( BOOST_TEST_CASE( &analyzeModelicaPendulum ) );
 
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &analyzeBoundedPendulum ) );
+
   framework::master_test_suite().
         add( BOOST_TEST_CASE( &analyzeCircuit1 ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_cache_roundtrip ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_cache_eviction ) );
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_cache_blt ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_session_roundtrip ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_session_from_input ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_session_corrupted ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_eliminate_circuit ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_eliminate_random ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_fast_path_index1 ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_fast_path_pendulum ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_fast_path_random ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_dulmage_mendelsohn ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_dulmage_mendelsohn_regular ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_singular_analysis ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_partial_circuit ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_partial_random ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_blt_triangular ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_blt_pendulum ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_blt_random ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_differentiated_pendulum ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_scheme_pendulum ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_scheme_modelica_pendulum ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_dummy_pendulum ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_dummy_modelica_pendulum ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_dummy_selection ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_tearing_loop ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_tearing_random ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_composite_circuit ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_composite_random ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_symmetry_circuit ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_symmetry_random ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_plan_pendulum_variants ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_plan_random_values ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_reorder_circuit ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_reorder_random ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_dense_pendulum ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_dense_random ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_dense_batch ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_dense_blocks ) );
+
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_lap_solver_random ) );
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_lap_solver_warm ) );
+  framework::master_test_suite().
+        add( BOOST_TEST_CASE( &test_lap_solver_c_api ) );
   
   return 0;
 }
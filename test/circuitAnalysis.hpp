@@ -20,9 +20,16 @@
 #ifndef DAESTRUCT_TEST_CIRCUIT_ANALYSIS_HPP
 #define DAESTRUCT_TEST_CIRCUIT_ANALYSIS_HPP
 
+#include <daestruct/analysis.hpp>
+
 namespace daestruct {
   namespace test {
 
+    /**
+     * Set the incidence of the circuit-model below
+     */
+    void setCircuitIncidence(daestruct::analysis::InputProblem& p);
+
     /**
      * Run structural analysis of the following circuit-model:
      *                      ||                          
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis.hpp>
+#include <daestruct/composite.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <random>
+#include <prettyprint.hpp>
+
+#include "compositeTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    void test_composite_circuit() {
+      /* variables u1, u2, uL, i1, i2, iL, uC, iC, interface i0 */
+      ComponentTemplate sub(8, 8, 1);
+      sub.set(0, 0, 0); sub.set(0, 3, 0);
+      sub.set(1, 1, 0); sub.set(1, 4, 0);
+      sub.set(2, 2, 0); sub.set(2, 5, 1);
+      sub.set(3, 3, 0); sub.set(3, 4, 0); sub.set(3, 5, 0);
+      sub.set(4, 2, 0); sub.set(4, 1, 0);
+      sub.set(5, 7, 0); sub.set(5, 6, 1);
+      sub.set(6, 6, 0); sub.set(6, 0, 0); sub.set(6, 1, 0);
+      sub.setInterface(7, 0, 0); sub.set(7, 3, 0); sub.set(7, 7, 0);
+
+      CompositeProblem circuit;
+      const int component = circuit.addTemplate(sub);
+      const int u0 = circuit.addVariable(), i0 = circuit.addVariable();
+      const int source = circuit.addEquation(), loop = circuit.addEquation();
+      circuit.set(source, u0, 0);
+      circuit.set(loop, u0, 0);
+
+      const int n = 50;
+      for (int k = 0; k < n; k++) {
+	const int s = circuit.instantiate(component, {i0});
+	circuit.set(loop, circuit.variable(s, 0), 0);
+	circuit.set(loop, circuit.variable(s, 2), 0);
+      }
+
+      const AnalysisResult res = circuit.analyse();
+      const AnalysisResult expected = circuit.flatten().pryceAlgorithm();
+      BOOST_CHECK_EQUAL( res.c, expected.c );
+      BOOST_CHECK_EQUAL( res.d, expected.d );
+
+      /* only the coupling was left to the global LAP */
+      BOOST_CHECK( res.stats.lap_dimension <= 3 );
+    }
+
+    void test_composite_random() {
+      for (unsigned int seed = 0; seed < 50; seed++) {
+	mt19937 gen(seed);
+	uniform_int_distribution<int> der(0, 2);
+
+	/* square, more variables, more equations */
+	std::vector<ComponentTemplate> templates;
+	for (int shape = 0; shape < 3; shape++) {
+	  const int eqs = 3 + (shape == 2), vars = 3 + (shape == 1);
+	  ComponentTemplate t(eqs, vars, 2);
+	  for (int i = 0; i < eqs; i++) {
+	    t.set(i, i % vars, der(gen));
+	    t.set(i, (i + 1 + gen() % (vars - 1)) % vars, der(gen));
+	  }
+	  t.setInterface(gen() % eqs, 0, der(gen));
+	  t.setInterface(gen() % eqs, 1, der(gen));
+	  templates.push_back(t);
+	}
+
+	CompositeProblem p;
+	for (const auto& t : templates)
+	  p.addTemplate(t);
+
+	const int globals = 4;
+	std::vector<int> variables;
+	for (int g = 0; g < globals; g++)
+	  variables.push_back(p.addVariable());
+
+	/* balance non-square instances by pairs */
+	for (int k = 0; k < 6; k++) {
+	  const int component = k < 4 ? 0 : (k == 4 ? 1 : 2);
+	  std::uniform_int_distribution<int> pick(0, variables.size() - 1);
+	  const int s = p.instantiate(component, {variables[pick(gen)], variables[pick(gen)]});
+	  for (int j = 0; j < templates[component].variables; j++)
+	    variables.push_back(p.variable(s, j));
+	}
+
+	for (int g = 0; g < globals; g++) {
+	  const int e = p.addEquation();
+	  p.set(e, g, der(gen));
+	  p.set(e, variables[gen() % variables.size()], der(gen));
+	}
+
+	InputProblem flat = p.flatten();
+	AnalysisResult expected;
+	try {
+	  expected = flat.pryceAlgorithm();
+	} catch (const StructurallySingular&) {
+	  BOOST_CHECK_THROW( p.analyse(), StructurallySingular );
+	  continue;
+	}
+
+	const AnalysisResult res = p.analyse();
+	BOOST_CHECK_EQUAL( res.c, expected.c );
+	BOOST_CHECK_EQUAL( res.d, expected.d );
+      }
+    }
+  }
+}
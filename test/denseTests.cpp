@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct.h>
+#include <daestruct/analysis.hpp>
+#include <daestruct/analysis_plan.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <prettyprint.hpp>
+
+#include <random>
+
+#include "eliminationTests.hpp"
+#include "denseTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    void test_dense_pendulum() {
+      /* equations x² + y² = L², der(der(x)) = F x, der(der(y)) = F y - g in x, y, F */
+      const int derivatives[] = { 0, 0, -1,
+				  2, -1, 0,
+				  -1, 2, 0 };
+      std::vector<int> c(3), d(3);
+      BOOST_REQUIRE_EQUAL( daestruct_analyse_dense(3, derivatives, c.data(), d.data()), 0 );
+      BOOST_CHECK_EQUAL( c, std::vector<int>({2, 0, 0}) );
+      BOOST_CHECK_EQUAL( d, std::vector<int>({2, 2, 0}) );
+
+      const int singular[] = { 0, -1, -1,
+			       0, -1, -1,
+			       0, 0, 0 };
+      BOOST_CHECK_EQUAL( daestruct_analyse_dense(3, singular, c.data(), d.data()), -1 );
+
+      const std::vector<int> large(65 * 65, 0);
+      std::vector<int> c65(65), d65(65);
+      BOOST_CHECK_EQUAL( daestruct_analyse_dense(65, large.data(), c65.data(), d65.data()), -1 );
+    }
+
+    void test_dense_random() {
+      for (unsigned int seed = 0; seed < 200; seed++) {
+	const int n = 1 + seed % 64;
+
+	InputProblem dense(n);
+	setRandomIncidence(dense, seed, 1 + seed % 3, 3);
+	dense.options.fast_path = false;
+	InputProblem sparse(n);
+	setRandomIncidence(sparse, seed, 1 + seed % 3, 3);
+	sparse.options.dense = false;
+
+	const AnalysisResult res = dense.pryceAlgorithm();
+	const AnalysisResult expected = sparse.pryceAlgorithm();
+
+	BOOST_CHECK( res.stats.dense );
+	BOOST_CHECK_EQUAL( res.c, expected.c );
+	BOOST_CHECK_EQUAL( res.d, expected.d );
+      }
+    }
+
+    void test_dense_batch() {
+      std::mt19937 gen(0);
+      for (int n = 1; n <= 24; n++) {
+	/* not a multiple of the lane count */
+	const int count = 3 + 5 * n;
+	std::vector<int> derivatives(count * n * n, -1);
+	for (int k = 0; k < count; k++)
+	  for (int i = 0; i < n; i++) {
+	    /* every fifth problem is likely singular */
+	    if (k % 5 || i == 0)
+	      derivatives[(k * n + i) * n + (i + k) % n] = gen() % 3;
+	    for (int e = 0; e < 2; e++)
+	      derivatives[(k * n + i) * n + gen() % n] = gen() % 4;
+	  }
+
+	std::vector<int> c(count * n), d(count * n), status(count);
+	const int failed = daestruct_analyse_batch(count, n, derivatives.data(), c.data(), d.data(), status.data());
+
+	int expected_failed = 0;
+	for (int k = 0; k < count; k++) {
+	  std::vector<int> ck(n), dk(n);
+	  const int res = daestruct_analyse_dense(n, derivatives.data() + k * n * n, ck.data(), dk.data());
+	  BOOST_CHECK_EQUAL( status[k], res );
+	  if (res < 0) {
+	    expected_failed++;
+	    continue;
+	  }
+	  BOOST_CHECK_EQUAL( std::vector<int>(c.begin() + k * n, c.begin() + (k + 1) * n), ck );
+	  BOOST_CHECK_EQUAL( std::vector<int>(d.begin() + k * n, d.begin() + (k + 1) * n), dk );
+	}
+	BOOST_CHECK_EQUAL( failed, expected_failed );
+      }
+    }
+
+    void test_dense_blocks() {
+      for (unsigned int seed = 0; seed < 20; seed++) {
+	const int n = 70 + seed;
+
+	InputProblem dense(n);
+	setRandomIncidence(dense, seed, 40, 3);
+	dense.options.fast_path = false;
+	InputProblem sparse(n);
+	setRandomIncidence(sparse, seed, 40, 3);
+	sparse.options.dense = false;
+
+	const AnalysisResult res = dense.pryceAlgorithm();
+	const AnalysisResult expected = sparse.pryceAlgorithm();
+	BOOST_CHECK_EQUAL( res.c, expected.c );
+	BOOST_CHECK_EQUAL( res.d, expected.d );
+
+	const AnalysisPlan plan(dense.sigma);
+	const AnalysisResult planned = plan.execute(plan.values(dense.sigma));
+	BOOST_CHECK_EQUAL( planned.c, expected.c );
+	BOOST_CHECK_EQUAL( planned.d, expected.d );
+      }
+    }
+  }
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAESTRUCT_TEST_DENSE_HPP
+#define DAESTRUCT_TEST_DENSE_HPP
+
+namespace daestruct {
+  namespace test {
+
+    /**
+     * The pendulum through daestruct_analyse_dense, singular and oversized input is rejected
+     */
+    void test_dense_pendulum();
+
+    /**
+     * Random problems up to the maximal dense dimension, against the sparse engine
+     */
+    void test_dense_random();
+
+    /**
+     * Batches of random (partly singular) problems, against daestruct_analyse_dense one by one
+     */
+    void test_dense_batch();
+
+    /**
+     * Nearly dense problems beyond the small engine, and an analysis plan of dense blocks, against the sparse LAP
+     */
+    void test_dense_blocks();
+  }
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis.hpp>
+#include <daestruct/differentiated_system.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <prettyprint.hpp>
+
+#include "differentiatedSystemTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    void test_differentiated_pendulum() {
+      /* x² + y² = 1, der(der(x)) = F*x, der(der(y)) = F*y - g */
+      InputProblem pendulum(3);
+      pendulum.sigma.insert(0, 0, 0);
+      pendulum.sigma.insert(0, 1, 0);
+      pendulum.sigma.insert(1, 0, -2);
+      pendulum.sigma.insert(1, 2, 0);
+      pendulum.sigma.insert(2, 1, -2);
+      pendulum.sigma.insert(2, 2, 0);
+
+      const AnalysisResult res = pendulum.pryceAlgorithm();
+      const DifferentiatedSystem system = differentiatedSystem(pendulum.sigma, res);
+
+      /* f_0, f_0', f_0'', f_1, f_2 in x, x', x'', y, y', y'', F */
+      BOOST_CHECK_EQUAL( system.equation_start, std::vector<int>({0, 3, 4, 5}) );
+      BOOST_CHECK_EQUAL( system.variable_start, std::vector<int>({0, 3, 6, 7}) );
+      BOOST_CHECK_EQUAL( system.incidence.rows, 5 );
+      BOOST_CHECK_EQUAL( system.incidence.columns, 7 );
+      BOOST_CHECK_EQUAL( system.incidence.row_start, std::vector<int>({0, 2, 6, 12, 16, 20}) );
+      /* f_0'' */
+      BOOST_CHECK_EQUAL( std::vector<int>(system.incidence.column.begin() + 6, system.incidence.column.begin() + 12),
+			 std::vector<int>({0, 1, 2, 3, 4, 5}) );
+
+      BOOST_CHECK_EQUAL( system.jacobian.row_start, std::vector<int>({0, 2, 4, 6}) );
+      BOOST_CHECK_EQUAL( system.jacobian.column, std::vector<int>({0, 1, 0, 2, 1, 2}) );
+
+      /* k = -2, -1: solve f_0^(k+2) for x^(k+2), y^(k+2) */
+      BOOST_REQUIRE_EQUAL( system.stages.size(), 3u );
+      for (int s = 0; s < 2; s++) {
+	const StageJacobian& stage = system.stages[s];
+	BOOST_CHECK_EQUAL( stage.k, s - 2 );
+	BOOST_CHECK_EQUAL( stage.equations, std::vector<int>({0}) );
+	BOOST_CHECK_EQUAL( stage.variables, std::vector<int>({0, 1}) );
+	BOOST_CHECK_EQUAL( stage.pattern.column, std::vector<int>({0, 1}) );
+      }
+
+      /* k = 0 is the complete system Jacobian */
+      const StageJacobian& last = system.stages.back();
+      BOOST_CHECK_EQUAL( last.k, 0 );
+      BOOST_CHECK_EQUAL( last.pattern.rows, 3 );
+      BOOST_CHECK_EQUAL( last.pattern.column, system.jacobian.column );
+    }
+  }
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis.hpp>
+#include <daestruct/dummy_derivatives.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <algorithm>
+#include <prettyprint.hpp>
+
+#include "dummyDerivativeTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    namespace {
+      bool jacobianEntry(const sigma_matrix& sigma, const AnalysisResult& res, int i, int j) {
+	auto row_iter = sigma.findRow(i);
+	for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	  if ((int)col_iter.index2() == j)
+	    return -*col_iter == res.d[j] - res.c[i];
+	return false;
+      }
+
+      /* the equations of a level can be matched to its selection along Jacobian entries */
+      bool nonsingular(const sigma_matrix& sigma, const AnalysisResult& res, const DummyDerivativeLevel& level) {
+	if (level.selected.size() != level.equations.size())
+	  return false;
+	std::vector<int> columns = level.selected;
+	std::sort(columns.begin(), columns.end());
+	do {
+	  bool matched = true;
+	  for (unsigned int k = 0; k < columns.size() && matched; k++) {
+	    const int i = level.equations[k], j = columns[k];
+	    matched = jacobianEntry(sigma, res, i, j);
+	  }
+	  if (matched)
+	    return true;
+	} while (std::next_permutation(columns.begin(), columns.end()));
+	return false;
+      }
+    }
+
+    void test_dummy_pendulum() {
+      InputProblem pendulum(3);
+      pendulum.sigma.insert(0, 0, 0);
+      pendulum.sigma.insert(0, 1, 0);
+      pendulum.sigma.insert(1, 0, -2);
+      pendulum.sigma.insert(1, 2, 0);
+      pendulum.sigma.insert(2, 1, -2);
+      pendulum.sigma.insert(2, 2, 0);
+      pendulum.options.blt = true;
+
+      const AnalysisResult res = pendulum.pryceAlgorithm();
+      const std::vector<DummyDerivativeLevel> levels = dummyDerivatives(pendulum.sigma, res);
+      BOOST_REQUIRE_EQUAL( levels.size(), 2u );
+
+      /* the constraint is differentiated twice, x'' or y'' first */
+      BOOST_CHECK_EQUAL( levels[0].level, 1 );
+      BOOST_CHECK_EQUAL( levels[0].equations, std::vector<int>({0}) );
+      BOOST_CHECK_EQUAL( levels[0].candidates, std::vector<int>({0, 1}) );
+      BOOST_CHECK_EQUAL( levels[0].selected.size(), 1u );
+      BOOST_CHECK( nonsingular(pendulum.sigma, res, levels[0]) );
+
+      /* then the first derivative of the same variable */
+      BOOST_CHECK_EQUAL( levels[1].level, 2 );
+      BOOST_CHECK_EQUAL( levels[1].candidates, levels[0].selected );
+      BOOST_CHECK_EQUAL( levels[1].selected, levels[0].selected );
+    }
+
+    void test_dummy_modelica_pendulum() {
+      /* x² + y² = 1, der(x) = vx, der(y) = vy, der(vx) = F*x, der(vy) = F*y - g */
+      InputProblem pendulum(5);
+      pendulum.sigma.insert(0, 0, 0);
+      pendulum.sigma.insert(0, 1, 0);
+      pendulum.sigma.insert(1, 0, -1);
+      pendulum.sigma.insert(1, 2, 0);
+      pendulum.sigma.insert(2, 1, -1);
+      pendulum.sigma.insert(2, 3, 0);
+      pendulum.sigma.insert(3, 0, 0);
+      pendulum.sigma.insert(3, 2, -1);
+      pendulum.sigma.insert(3, 4, 0);
+      pendulum.sigma.insert(4, 1, 0);
+      pendulum.sigma.insert(4, 3, -1);
+      pendulum.sigma.insert(4, 4, 0);
+      pendulum.options.blt = true;
+
+      const AnalysisResult res = pendulum.pryceAlgorithm();
+      const std::vector<DummyDerivativeLevel> levels = dummyDerivatives(pendulum.sigma, res);
+
+      /* c = (2, 1, 1, 0, 0): three equations at level 1, the constraint at level 2 */
+      BOOST_REQUIRE_EQUAL( levels.size(), 2u );
+      BOOST_CHECK_EQUAL( levels[0].equations.size(), 3u );
+      BOOST_CHECK_EQUAL( levels[1].equations, std::vector<int>({0}) );
+
+      for (const DummyDerivativeLevel& level : levels) {
+	BOOST_CHECK( nonsingular(pendulum.sigma, res, level) );
+	for (int j : level.selected)
+	  BOOST_CHECK( std::find(level.candidates.begin(), level.candidates.end(), j) != level.candidates.end() );
+      }
+    }
+
+    void test_dummy_selection() {
+      /* x² + y² = 1, der(x) = vx, der(y) = vy, der(vx) = F*x, der(vy) = F*y - g */
+      InputProblem pendulum(5);
+      pendulum.sigma.insert(0, 0, 0);
+      pendulum.sigma.insert(0, 1, 0);
+      pendulum.sigma.insert(1, 0, -1);
+      pendulum.sigma.insert(1, 2, 0);
+      pendulum.sigma.insert(2, 1, -1);
+      pendulum.sigma.insert(2, 3, 0);
+      pendulum.sigma.insert(3, 0, 0);
+      pendulum.sigma.insert(3, 2, -1);
+      pendulum.sigma.insert(3, 4, 0);
+      pendulum.sigma.insert(4, 1, 0);
+      pendulum.sigma.insert(4, 3, -1);
+      pendulum.sigma.insert(4, 4, 0);
+      pendulum.options.blt = true;
+
+      const AnalysisResult res = pendulum.pryceAlgorithm();
+
+      /* the selection is a matching within the candidates, not the assignment of the analysis */
+      AnalysisResult unassigned = res;
+      unassigned.row_assignment.assign(5, -1);
+      unassigned.col_assignment.assign(5, -1);
+
+      const std::vector<DummyDerivativeLevel> levels = dummyDerivatives(pendulum.sigma, unassigned);
+      BOOST_REQUIRE_EQUAL( levels.size(), 2u );
+      for (const DummyDerivativeLevel& level : levels) {
+	BOOST_CHECK( nonsingular(pendulum.sigma, res, level) );
+	for (int j : level.selected)
+	  BOOST_CHECK( std::find(level.candidates.begin(), level.candidates.end(), j) != level.candidates.end() );
+      }
+    }
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <daestruct/analysis.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <prettyprint.hpp>
+
+#include "circuitAnalysis.hpp"
+#include "eliminationTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    void setRandomIncidence(InputProblem& p, unsigned int seed, int density, int maxDerivative) {
+      const int n = p.dimension;
+      mt19937 gen(seed);
+      uniform_int_distribution<int> col(0, n - 1);
+      uniform_int_distribution<int> der(0, maxDerivative);
+      uniform_int_distribution<int> len(0, 2 * density);
+
+      std::vector<int> perm(n);
+      for (int i = 0; i < n; i++)
+	perm[i] = i;
+      shuffle(perm.begin(), perm.end(), gen);
+
+      for (int i = 0; i < n; i++) {
+	std::set<int> cols({perm[i]});
+	for (int k = len(gen); k > 0; k--)
+	  cols.insert(col(gen));
+	for (int j : cols)
+	  p.sigma.insert(i, j, -der(gen));
+      }
+    }
+
+    void test_eliminate_circuit() {
+      InputProblem circuit(10);
+      setCircuitIncidence(circuit);
+
+      const AnalysisResult res = circuit.pryceAlgorithm();
+      BOOST_CHECK_EQUAL( res.stats.lap_dimension, 0 );
+      BOOST_CHECK_EQUAL( res.c, std::vector<int>({1, 1, 1, 0, 0, 1, 1, 1, 0, 1}) );
+    }
+
+    void test_eliminate_random() {
+      for (unsigned int seed = 0; seed < 200; seed++) {
+	const int n = 1 + seed % 40;
+
+	InputProblem reduced(n);
+	setRandomIncidence(reduced, seed, 1 + seed % 3, 3);
+	InputProblem full(n);
+	setRandomIncidence(full, seed, 1 + seed % 3, 3);
+	full.options.eliminate = false;
+	reduced.options.dense = full.options.dense = false;
+
+	const AnalysisResult res = reduced.pryceAlgorithm();
+	const AnalysisResult expected = full.pryceAlgorithm();
+
+	BOOST_CHECK_EQUAL( res.c, expected.c );
+	BOOST_CHECK_EQUAL( res.d, expected.d );
+      }
+    }
+  }
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DAESTRUCT_TEST_ELIMINATION_HPP
+#define DAESTRUCT_TEST_ELIMINATION_HPP
+
+#include <daestruct/analysis.hpp>
+
+namespace daestruct {
+  namespace test {
+
+    /**
+     * Fill p with a random, structurally nonsingular incidence
+     * (a random transversal plus about density entries per row)
+     */
+    void setRandomIncidence(daestruct::analysis::InputProblem& p, unsigned int seed, int density, int maxDerivative);
+
+    /**
+     * The circuit is solved completely by the pre-pass
+     */
+    void test_eliminate_circuit();
+
+    /**
+     * Random problems yield the same offsets with and without the pre-pass
+     */
+    void test_eliminate_random();
+  }
+}
+
+#endif
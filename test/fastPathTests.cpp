@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <prettyprint.hpp>
+
+#include "eliminationTests.hpp"
+#include "fastPathTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    void test_fast_path_index1() {
+      /*
+       * der(x) = -x + y
+       * 0 = x + y + z
+       * z = der(x)
+       * variables: x, y, z
+       */
+      InputProblem p(3);
+      p.sigma.insert(0, 0, -1);
+      p.sigma.insert(0, 1, 0);
+      p.sigma.insert(1, 0, 0);
+      p.sigma.insert(1, 1, 0);
+      p.sigma.insert(1, 2, 0);
+      p.sigma.insert(2, 0, -1);
+      p.sigma.insert(2, 2, 0);
+
+      const AnalysisResult res = p.pryceAlgorithm();
+      BOOST_CHECK( res.stats.fast_path );
+      BOOST_CHECK_EQUAL( res.stats.lap_dimension, 0 );
+      BOOST_CHECK_EQUAL( res.c, std::vector<int>({0, 0, 0}) );
+      BOOST_CHECK_EQUAL( res.d, std::vector<int>({1, 0, 0}) );
+    }
+
+    void test_fast_path_pendulum() {
+      InputProblem pendulum(3);
+      pendulum.sigma.insert(0, 0, 0);
+      pendulum.sigma.insert(0, 1, 0);
+      pendulum.sigma.insert(1, 0, -2);
+      pendulum.sigma.insert(1, 2, 0);
+      pendulum.sigma.insert(2, 1, -2);
+      pendulum.sigma.insert(2, 2, 0);
+
+      const AnalysisResult res = pendulum.pryceAlgorithm();
+      BOOST_CHECK( !res.stats.fast_path );
+      BOOST_CHECK_EQUAL( res.c, std::vector<int>({2, 0, 0}) );
+    }
+
+    void test_fast_path_random() {
+      int certified = 0;
+      for (unsigned int seed = 0; seed < 200; seed++) {
+	const int n = 1 + seed % 40;
+
+	InputProblem fast(n);
+	setRandomIncidence(fast, seed, 1 + seed % 3, 1);
+	InputProblem full(n);
+	setRandomIncidence(full, seed, 1 + seed % 3, 1);
+	full.options.fast_path = false;
+
+	const AnalysisResult res = fast.pryceAlgorithm();
+	const AnalysisResult expected = full.pryceAlgorithm();
+
+	BOOST_CHECK_EQUAL( res.c, expected.c );
+	BOOST_CHECK_EQUAL( res.d, expected.d );
+	if (res.stats.fast_path)
+	  certified++;
+      }
+
+      /* the check must actually fire on some of them */
+      BOOST_CHECK( certified > 0 );
+    }
+  }
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/lap_solver.h>
+#include <daestruct/lap_solver.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <lap.hpp>
+#include <prettyprint.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "lapSolverTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+
+    /* a random n x n problem in CSR form with a perfect matching, rows are shuffled */
+    struct csr_problem {
+      int n;
+      std::vector<int64_t> row_start;
+      std::vector<int> columns;
+      std::vector<int64_t> costs;
+
+      csr_problem(int dim, std::mt19937& gen) : n(dim), row_start(1, 0) {
+	std::vector<int> perm(n);
+	for (int k = 0; k < n; k++)
+	  perm[k] = k;
+	std::shuffle(perm.begin(), perm.end(), gen);
+
+	std::uniform_int_distribution<int> column(0, n - 1), cost(-1000, 1000);
+	std::uniform_int_distribution<int64_t> offset(-1000000000000LL, 1000000000000LL);
+	for (int i = 0; i < n; i++) {
+	  std::vector<int> row(1, perm[i]);
+	  for (int k = 0; k < 4; k++)
+	    row.push_back(column(gen));
+	  std::sort(row.begin(), row.end());
+	  row.erase(std::unique(row.begin(), row.end()), row.end());
+	  std::shuffle(row.begin(), row.end(), gen);
+
+	  const int64_t base = offset(gen);
+	  for (const int j : row) {
+	    columns.push_back(j);
+	    costs.push_back(base + cost(gen));
+	  }
+	  row_start.push_back(columns.size());
+	}
+      }
+
+      /* the optimal cost by dense_lap on the costs relative to the row minima */
+      int64_t reference() const {
+	std::vector<int> dense(n * n, BIG);
+	int64_t shift = 0;
+	for (int i = 0; i < n; i++) {
+	  const int64_t lo = *std::min_element(costs.begin() + row_start[i], costs.begin() + row_start[i + 1]);
+	  shift += lo;
+	  for (int64_t e = row_start[i]; e < row_start[i + 1]; e++)
+	    dense[i * n + columns[e]] = costs[e] - lo;
+	}
+	return dense_lap(n, dense).cost + shift;
+      }
+    };
+
+    /* primal and dual feasibility, complementary slackness and the total cost */
+    static void check_optimality(const csr_problem& p, const LapSolver& solver) {
+      const std::vector<int>& rowsol = solver.row_assignment();
+      const std::vector<int>& colsol = solver.col_assignment();
+      const std::vector<int64_t>& u = solver.row_duals();
+      const std::vector<int>& v = solver.column_duals();
+
+      int64_t total = 0;
+      for (int i = 0; i < p.n; i++) {
+	BOOST_REQUIRE( rowsol[i] >= 0 && rowsol[i] < p.n );
+	BOOST_CHECK_EQUAL( colsol[rowsol[i]], i );
+	bool matched = false;
+	for (int64_t e = p.row_start[i]; e < p.row_start[i + 1]; e++) {
+	  const int j = p.columns[e];
+	  BOOST_CHECK( u[i] + v[j] <= p.costs[e] );
+	  if (j == rowsol[i]) {
+	    BOOST_CHECK_EQUAL( u[i] + v[j], p.costs[e] );
+	    total += p.costs[e];
+	    matched = true;
+	  }
+	}
+	BOOST_CHECK( matched );
+      }
+      BOOST_CHECK_EQUAL( total, solver.cost() );
+    }
+
+    void test_lap_solver_random() {
+      std::mt19937 gen(74);
+      LapSolver solver;
+      for (int round = 0; round < 100; round++) {
+	const csr_problem p(1 + round * 7 % 120, gen);
+	BOOST_REQUIRE( solver.solve(p.n, p.row_start.data(), p.columns.data(), p.costs.data()) );
+	BOOST_CHECK_EQUAL( solver.cost(), p.reference() );
+	check_optimality(p, solver);
+      }
+    }
+
+    void test_lap_solver_warm() {
+      std::mt19937 gen(75);
+      LapSolver solver;
+      for (int round = 0; round < 50; round++) {
+	csr_problem p(20 + round, gen);
+	BOOST_REQUIRE( solver.solve(p.n, p.row_start.data(), p.columns.data(), p.costs.data()) );
+	const std::vector<int> rowsol = solver.row_assignment();
+	const std::vector<int> v = solver.column_duals();
+
+	/* change a few costs, the old solution is a start, but (in general) not optimal */
+	std::uniform_int_distribution<int> entry(0, p.columns.size() - 1), cost(-500, 500);
+	for (int k = 0; k < 5; k++)
+	  p.costs[entry(gen)] += cost(gen);
+	const int64_t optimum = p.reference();
+
+	BOOST_REQUIRE( solver.solve(p.n, p.row_start.data(), p.columns.data(), p.costs.data(), rowsol.data(), v.data()) );
+	BOOST_CHECK_EQUAL( solver.cost(), optimum );
+	check_optimality(p, solver);
+
+	BOOST_REQUIRE( solver.solve(p.n, p.row_start.data(), p.columns.data(), p.costs.data(), nullptr, v.data()) );
+	BOOST_CHECK_EQUAL( solver.cost(), optimum );
+	check_optimality(p, solver);
+
+	BOOST_REQUIRE( solver.solve(p.n, p.row_start.data(), p.columns.data(), p.costs.data(), rowsol.data(), nullptr) );
+	BOOST_CHECK_EQUAL( solver.cost(), optimum );
+	check_optimality(p, solver);
+      }
+    }
+
+    void test_lap_solver_c_api() {
+      /* rows {0: 5, 1: 1}, {2: 4, 0: 2}, {1: 3, 2: 7} */
+      const int64_t row_start[] = { 0, 2, 4, 6 };
+      const int columns[] = { 0, 1, 2, 0, 1, 2 };
+      const int64_t costs[] = { 5, 1, 4, 2, 3, 7 };
+
+      struct daestruct_lap_solver* solver = daestruct_lap_solver_create();
+      BOOST_REQUIRE_EQUAL( daestruct_lap_solve(solver, 3, row_start, columns, costs), 0 );
+      BOOST_CHECK_EQUAL( daestruct_lap_cost(solver), 10 );
+      const int* rowsol = daestruct_lap_row_assignment(solver);
+      const int* colsol = daestruct_lap_col_assignment(solver);
+      BOOST_CHECK_EQUAL( std::vector<int>(rowsol, rowsol + 3), std::vector<int>({1, 0, 2}) );
+      BOOST_CHECK_EQUAL( std::vector<int>(colsol, colsol + 3), std::vector<int>({1, 0, 2}) );
+      const int64_t* u = daestruct_lap_row_duals(solver);
+      const int* v = daestruct_lap_column_duals(solver);
+      BOOST_CHECK_EQUAL( u[0] + v[1], 1 );
+      BOOST_CHECK_EQUAL( u[1] + v[0], 2 );
+      BOOST_CHECK_EQUAL( u[2] + v[2], 7 );
+
+      const int start[] = { 1, -1, 2 };
+      BOOST_CHECK_EQUAL( daestruct_lap_solve_warm(solver, 3, row_start, columns, costs, start, nullptr), 0 );
+      BOOST_CHECK_EQUAL( daestruct_lap_cost(solver), 10 );
+
+      /* column 2 is missing */
+      const int columns_singular[] = { 0, 1, 1, 0, 1, 0 };
+      BOOST_CHECK_EQUAL( daestruct_lap_solve(solver, 3, row_start, columns_singular, costs), 1 );
+
+      const int columns_duplicate[] = { 0, 0, 2, 0, 1, 2 };
+      BOOST_CHECK_EQUAL( daestruct_lap_solve(solver, 3, row_start, columns_duplicate, costs), -1 );
+
+      /* a descending row_start must not size any buffer */
+      const int64_t row_start_descending[] = { 0, -5 };
+      BOOST_CHECK_EQUAL( daestruct_lap_solve(solver, 1, row_start_descending, columns, costs), -1 );
+      const int64_t row_start_dip[] = { 0, 4, 2, 6 };
+      BOOST_CHECK_EQUAL( daestruct_lap_solve(solver, 3, row_start_dip, columns, costs), -1 );
+
+      const int64_t costs_wide[] = { 0, 1LL << 40, 4, 2, 3, 7 };
+      BOOST_CHECK_EQUAL( daestruct_lap_solve(solver, 3, row_start, columns, costs_wide), -1 );
+
+      daestruct_lap_solver_delete(solver);
+    }
+  }
+}
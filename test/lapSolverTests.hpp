@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAESTRUCT_TEST_LAP_SOLVER_HPP
+#define DAESTRUCT_TEST_LAP_SOLVER_HPP
+
+namespace daestruct {
+  namespace test {
+
+    /**
+     * Random sparse problems with large 64 bit costs and unsorted rows, solved by one LapSolver against dense_lap
+     */
+    void test_lap_solver_random();
+
+    /**
+     * Warm starts from the solution of a perturbed problem, from its duals and from its matching only
+     */
+    void test_lap_solver_warm();
+
+    /**
+     * The C API, including singular and malformed input
+     */
+    void test_lap_solver_c_api();
+  }
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis.hpp>
+#include <daestruct/partial_analysis.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <random>
+#include <stdexcept>
+#include <prettyprint.hpp>
+
+#include "circuitAnalysis.hpp"
+#include "eliminationTests.hpp"
+#include "partialAnalysisTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    void checkPartial(const PartialResult& partial, const AnalysisResult& full) {
+      BOOST_REQUIRE_EQUAL( partial.c.size(), partial.equations.size() );
+      BOOST_REQUIRE_EQUAL( partial.d.size(), partial.variables.size() );
+      for (unsigned int k = 0; k < partial.equations.size(); k++)
+	BOOST_CHECK_EQUAL( partial.c[k], full.c[partial.equations[k]] );
+      for (unsigned int k = 0; k < partial.variables.size(); k++)
+	BOOST_CHECK_EQUAL( partial.d[k], full.d[partial.variables[k]] );
+    }
+
+    void test_partial_circuit() {
+      InputProblem circuit(10);
+      setCircuitIncidence(circuit);
+
+      const AnalysisResult full = circuit.pryceAlgorithm();
+      const AnalysisResult assigned = circuit.assign();
+      const PartialAnalysis partial(circuit.sigma, assigned.row_assignment);
+
+      for (int k = 0; k < 10; k++) {
+	const PartialResult byVariable = partial.query({}, {k});
+	BOOST_CHECK_EQUAL( byVariable.variables.front(), k );
+	checkPartial(byVariable, full);
+
+	const PartialResult byEquation = partial.query({k}, {});
+	BOOST_CHECK_EQUAL( byEquation.equations.front(), k );
+	checkPartial(byEquation, full);
+      }
+
+      BOOST_CHECK_THROW( partial.query({10}, {}), std::invalid_argument );
+      BOOST_CHECK_THROW( partial.query({}, {-1}), std::invalid_argument );
+      BOOST_CHECK_THROW( partial.query({0}, {0, 10}), std::invalid_argument );
+    }
+
+    void test_partial_random() {
+      for (unsigned int seed = 0; seed < 100; seed++) {
+	const int n = 1 + seed % 50;
+
+	InputProblem p(n);
+	setRandomIncidence(p, seed, 1, 3);
+	const AnalysisResult full = p.pryceAlgorithm();
+	const PartialAnalysis partial(p.sigma, full.row_assignment);
+
+	mt19937 gen(seed);
+	uniform_int_distribution<int> index(0, n - 1);
+	checkPartial(partial.query({index(gen)}, {index(gen), index(gen)}), full);
+      }
+    }
+  }
+}
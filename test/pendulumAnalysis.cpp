@@ -113,6 +113,21 @@ namespace daestruct {
       BOOST_CHECK_EQUAL( res.d, std::vector<int>({2,2,1,1,0}) );
       BOOST_CHECK_EQUAL( res.c, std::vector<int>({2,1,1,0,0}) );
     }
+
+    void analyzeBoundedPendulum() {
+      InputProblem pendulum(3);
+      setIncidence(pendulum);
+
+      /* the constraint needs two differentiations */
+      pendulum.options.max_offset = 1;
+      const AnalysisResult rejected = pendulum.pryceAlgorithm();
+      BOOST_CHECK_EQUAL( rejected.bound_witness, 0 );
+
+      pendulum.options.max_offset = 2;
+      const AnalysisResult res = pendulum.pryceAlgorithm();
+      BOOST_CHECK_EQUAL( res.bound_witness, -1 );
+      BOOST_CHECK_EQUAL( res.c, std::vector<int>({2,0,0}) );
+    }
     
   }
 }
@@ -33,6 +33,11 @@ namespace daestruct {
      * described as in Modelica (i.e. maximum source derivative = 1)
      */
     void analyzeModelicaPendulum();
+
+    /**
+     * Reject the pendulum by an offset bound of 1, accept it with 2
+     */
+    void analyzeBoundedPendulum();
   }
 }
 #endif
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <prettyprint.hpp>
+
+#include "circuitAnalysis.hpp"
+#include "eliminationTests.hpp"
+#include "reorderingTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    void test_reorder_circuit() {
+      InputProblem circuit(10);
+      setCircuitIncidence(circuit);
+      circuit.options.eliminate = false;
+      circuit.options.fast_path = false;
+      circuit.options.reorder = true;
+      circuit.options.dense = false;
+
+      const AnalysisResult res = circuit.pryceAlgorithm();
+      BOOST_CHECK_EQUAL( res.d, std::vector<int>({1, 1, 1, 1, 1, 0, 1, 1, 0, 1}) );
+      BOOST_CHECK_EQUAL( res.c, std::vector<int>({1, 1, 1, 0, 0, 1, 1, 1, 0, 1}) );
+
+      for (int i = 0; i < 10; i++)
+	BOOST_CHECK_EQUAL( res.col_assignment[res.row_assignment[i]], i );
+    }
+
+    void test_reorder_random() {
+      for (unsigned int seed = 0; seed < 40; seed++) {
+	const int n = 20 + 3 * seed;
+	InputProblem reordered(n);
+	setRandomIncidence(reordered, seed, 1 + seed % 3, 3);
+	InputProblem original(n);
+	setRandomIncidence(original, seed, 1 + seed % 3, 3);
+
+	reordered.options.reorder = true;
+	reordered.options.dense = false;
+	reordered.options.eliminate = original.options.eliminate = seed % 2;
+
+	const AnalysisResult res = reordered.pryceAlgorithm();
+	const AnalysisResult expected = original.pryceAlgorithm();
+	BOOST_CHECK_EQUAL( res.c, expected.c );
+	BOOST_CHECK_EQUAL( res.d, expected.d );
+      }
+    }
+  }
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DAESTRUCT_TEST_REORDERING_HPP
+#define DAESTRUCT_TEST_REORDERING_HPP
+
+namespace daestruct {
+  namespace test {
+
+    /**
+     * The circuit example, solved in reverse Cuthill-McKee order
+     */
+    void test_reorder_circuit();
+
+    /**
+     * Random problems with and without elimination, against the original order
+     */
+    void test_reorder_random();
+  }
+}
+
+#endif
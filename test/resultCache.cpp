@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <daestruct/analysis.hpp>
+#include <daestruct/result_cache.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/filesystem.hpp>
+
+#include <prettyprint.hpp>
+
+#include <ctime>
+#include <fstream>
+
+#include "circuitAnalysis.hpp"
+#include "resultCache.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+    namespace fs = boost::filesystem;
+
+    void test_cache_roundtrip() {
+      const fs::path dir = fs::temp_directory_path() / fs::unique_path();
+      ResultCache cache(dir.string(), 0);
+
+      InputProblem circuit(10);
+      setCircuitIncidence(circuit);
+
+      AnalysisResult cached;
+      BOOST_CHECK( !cache.lookup(circuit.sigma, cached) );
+
+      const AnalysisResult res = cache.analyse(circuit);
+      BOOST_REQUIRE( cache.lookup(circuit.sigma, cached) );
+
+      BOOST_CHECK_EQUAL( cached.c, res.c );
+      BOOST_CHECK_EQUAL( cached.d, res.d );
+      BOOST_CHECK_EQUAL( cached.row_assignment, res.row_assignment );
+      BOOST_CHECK_EQUAL( cached.col_assignment, res.col_assignment );
+
+      /* an additional derivative is a different key */
+      InputProblem changed(10);
+      setCircuitIncidence(changed);
+      changed.sigma.insert(0, 9, -1);
+      BOOST_CHECK( !cache.lookup(changed.sigma, cached) );
+
+      fs::remove_all(dir);
+    }
+
+    /* the records in dir, there is one file per record */
+    static std::vector<fs::path> records(const fs::path& dir) {
+      std::vector<fs::path> files;
+      for (fs::directory_iterator it(dir), end; it != end; ++it)
+	files.push_back(it->path());
+      return files;
+    }
+
+    /* the cache orders by modification time (in seconds), move a record into the past */
+    static void age(const fs::path& dir, const sigma_matrix& sigma, std::time_t seconds) {
+      const fs::path file = dir / (SigmaHash(sigma).str() + ".dsr");
+      BOOST_REQUIRE( fs::exists(file) );
+      fs::last_write_time(file, std::time(nullptr) - seconds);
+    }
+
+    void test_cache_eviction() {
+      /* three different problems of the same record size */
+      std::vector<InputProblem> problems;
+      for (int k = 0; k < 3; k++) {
+	problems.emplace_back(10);
+	setCircuitIncidence(problems.back());
+	if (k > 0)
+	  problems.back().sigma.insert(0, 9, -k);
+      }
+
+      const fs::path probe = fs::temp_directory_path() / fs::unique_path();
+      ResultCache(probe.string(), 0).analyse(problems[0]);
+      const uint64_t record = fs::file_size(records(probe).at(0));
+      fs::remove_all(probe);
+
+      AnalysisResult cached;
+      {
+	const fs::path dir = fs::temp_directory_path() / fs::unique_path();
+	ResultCache cache(dir.string(), record);
+	cache.analyse(problems[0]);
+	age(dir, problems[0].sigma, 100);
+	cache.analyse(problems[1]);
+
+	BOOST_CHECK( !cache.lookup(problems[0].sigma, cached) );
+	BOOST_CHECK( cache.lookup(problems[1].sigma, cached) );
+	fs::remove_all(dir);
+      }
+
+      {
+	const fs::path dir = fs::temp_directory_path() / fs::unique_path();
+	ResultCache cache(dir.string(), 2 * record);
+	cache.analyse(problems[0]);
+	cache.analyse(problems[1]);
+	age(dir, problems[0].sigma, 200);
+	age(dir, problems[1].sigma, 100);
+
+	/* the older record is used again, the other one goes */
+	BOOST_REQUIRE( cache.lookup(problems[0].sigma, cached) );
+	cache.analyse(problems[2]);
+
+	BOOST_CHECK( cache.lookup(problems[0].sigma, cached) );
+	BOOST_CHECK( !cache.lookup(problems[1].sigma, cached) );
+	BOOST_CHECK( cache.lookup(problems[2].sigma, cached) );
+	fs::remove_all(dir);
+      }
+
+      {
+	/* a well-formed record whose d is shorter than the dimension is a miss */
+	const fs::path dir = fs::temp_directory_path() / fs::unique_path();
+	ResultCache cache(dir.string(), 0);
+	cache.analyse(problems[0]);
+	const fs::path file = records(dir).at(0);
+
+	/* header (magic, version, hash, dimension, nnz), then three vectors of 10 ints before d */
+	const std::size_t d_size = 2 * 4 + 4 * 8 + 3 * (8 + 10 * 4);
+	{
+	  std::fstream f(file.string(), std::ios::in | std::ios::out | std::ios::binary);
+	  const int64_t shorter = 5;
+	  f.seekp(d_size);
+	  f.write(reinterpret_cast<const char*>(&shorter), sizeof(shorter));
+	}
+	fs::resize_file(file, d_size + 8 + 5 * 4);
+	BOOST_CHECK( !cache.lookup(problems[0].sigma, cached) );
+	fs::remove_all(dir);
+      }
+    }
+
+    void test_cache_blt() {
+      const fs::path dir = fs::temp_directory_path() / fs::unique_path();
+      ResultCache cache(dir.string(), 0);
+
+      InputProblem circuit(10);
+      setCircuitIncidence(circuit);
+      circuit.options.blt = true;
+
+      const AnalysisResult miss = cache.analyse(circuit);
+      BOOST_REQUIRE( miss.blt.blocks() > 0 );
+
+      const AnalysisResult hit = cache.analyse(circuit);
+      BOOST_CHECK_EQUAL( hit.blt.blocks(), miss.blt.blocks() );
+      BOOST_CHECK_EQUAL( hit.blt.equations, miss.blt.equations );
+      BOOST_CHECK_EQUAL( hit.blt.variables, miss.blt.variables );
+      BOOST_CHECK_EQUAL( hit.blt.block_start, miss.blt.block_start );
+
+      fs::remove_all(dir);
+    }
+  }
+}
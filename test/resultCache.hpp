@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DAESTRUCT_TEST_RESULT_CACHE_HPP
+#define DAESTRUCT_TEST_RESULT_CACHE_HPP
+
+namespace daestruct {
+  namespace test {
+
+    /**
+     * Store the circuit analysis in a fresh cache and read it back
+     */
+    void test_cache_roundtrip();
+
+    /**
+     * A cache bounded to one record keeps the latest one, a cache bounded to two records
+     * evicts the least recently used one, a lookup counts as a use. Corrupted records are misses.
+     */
+    void test_cache_eviction();
+
+    /**
+     * With options.blt, a cache hit carries the same BLT as the miss that stored it
+     */
+    void test_cache_blt();
+  }
+}
+
+#endif
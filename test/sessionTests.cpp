@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <daestruct/analysis.hpp>
+#include <daestruct/variable_analysis.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <sstream>
+#include <cstring>
+#include <prettyprint.hpp>
+
+#include "circuitAnalysis.hpp"
+#include "sessionTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    /**
+     * replace uL=u2 by uL=der(u2)
+     */
+    StructChange differentiateAlias() {
+      StructChange change;
+      change.newVars = 0;
+      change.deletedRows.insert(7);
+
+      NewRow row;
+      row.ex_vars[4] = 0;
+      row.ex_vars[2] = -1;
+      change.newRows.push_back(row);
+      return change;
+    }
+
+    /**
+     * and back again
+     */
+    StructChange restoreAlias() {
+      StructChange change;
+      change.newVars = 0;
+      change.deletedRows.insert(9);
+
+      NewRow row;
+      row.ex_vars[4] = 0;
+      row.ex_vars[2] = 0;
+      change.newRows.push_back(row);
+      return change;
+    }
+
+    void test_session_roundtrip() {
+      InputProblem circuit(10);
+      setCircuitIncidence(circuit);
+      const AnalysisResult res = circuit.pryceAlgorithm();
+
+      ChangedProblem changed(circuit, res, differentiateAlias());
+      const AnalysisResult changedRes = changed.pryceAlgorithm();
+
+      stringstream snapshot;
+      saveSession(snapshot, changed, changedRes);
+
+      AnalysisResult restoredRes;
+      unique_ptr<ChangedProblem> restored = restoreSession(snapshot, restoredRes);
+      BOOST_REQUIRE( restored );
+
+      BOOST_CHECK_EQUAL( restored->dimension, changed.dimension );
+      BOOST_CHECK_EQUAL( restored->row_assignment, changed.row_assignment );
+      BOOST_CHECK_EQUAL( restored->dual_columns, changed.dual_columns );
+      BOOST_CHECK( restored->rowOffsets == changed.rowOffsets );
+      BOOST_CHECK( restored->colOffsets == changed.colOffsets );
+      BOOST_CHECK_EQUAL( restoredRes.c, changedRes.c );
+      BOOST_CHECK_EQUAL( restoredRes.d, changedRes.d );
+
+      ChangedProblem next(changed, changedRes, restoreAlias());
+      ChangedProblem restoredNext(*restored, restoredRes, restoreAlias());
+
+      const AnalysisResult nextRes = next.pryceAlgorithm();
+      const AnalysisResult restoredNextRes = restoredNext.pryceAlgorithm();
+
+      BOOST_CHECK_EQUAL( restoredNextRes.c, nextRes.c );
+      BOOST_CHECK_EQUAL( restoredNextRes.d, nextRes.d );
+    }
+
+    void test_session_from_input() {
+      InputProblem circuit(10);
+      setCircuitIncidence(circuit);
+      const AnalysisResult res = circuit.pryceAlgorithm();
+
+      stringstream snapshot;
+      saveSession(snapshot, circuit, res);
+
+      AnalysisResult restoredRes;
+      unique_ptr<ChangedProblem> restored = restoreSession(snapshot, restoredRes);
+      BOOST_REQUIRE( restored );
+
+      ChangedProblem changed(circuit, res, differentiateAlias());
+      ChangedProblem restoredChanged(*restored, restoredRes, differentiateAlias());
+
+      const AnalysisResult changedRes = changed.pryceAlgorithm();
+      const AnalysisResult restoredChangedRes = restoredChanged.pryceAlgorithm();
+
+      BOOST_CHECK_EQUAL( restoredChangedRes.c, changedRes.c );
+      BOOST_CHECK_EQUAL( restoredChangedRes.d, changedRes.d );
+
+      stringstream garbage("not a session");
+      BOOST_CHECK( !restoreSession(garbage, restoredRes) );
+    }
+
+    namespace {
+      template<typename T> void patch(string& bytes, size_t pos, T value) {
+	memcpy(&bytes[pos], &value, sizeof(T));
+      }
+
+      bool restores(const string& bytes) {
+	stringstream i(bytes);
+	AnalysisResult res;
+	return static_cast<bool>(restoreSession(i, res));
+      }
+    }
+
+    void test_session_corrupted() {
+      InputProblem circuit(10);
+      setCircuitIncidence(circuit);
+      const AnalysisResult res = circuit.pryceAlgorithm();
+
+      ChangedProblem changed(circuit, res, differentiateAlias());
+      const AnalysisResult changedRes = changed.pryceAlgorithm();
+
+      stringstream snapshot;
+      saveSession(snapshot, changed, changedRes);
+      const string valid = snapshot.str();
+      BOOST_REQUIRE( restores(valid) );
+
+      const int n = changed.dimension;
+      /* header: magic, version, dimension, old_rows, old_columns */
+      const size_t old_rows_pos = 3 * sizeof(int32_t);
+      const size_t old_columns_pos = 4 * sizeof(int32_t);
+      /* the result vectors come last, each one a length followed by n entries */
+      const size_t vector_bytes = sizeof(int64_t) + n * sizeof(int);
+      const size_t result_pos = valid.size() - 4 * vector_bytes;
+
+      string bytes = valid;
+      patch<int32_t>(bytes, old_rows_pos, n + 1);
+      BOOST_CHECK( !restores(bytes) );
+
+      bytes = valid;
+      patch<int32_t>(bytes, old_columns_pos, -1);
+      BOOST_CHECK( !restores(bytes) );
+
+      /* an out of range and an inconsistent result assignment */
+      bytes = valid;
+      patch<int>(bytes, result_pos + sizeof(int64_t), n);
+      BOOST_CHECK( !restores(bytes) );
+
+      bytes = valid;
+      patch<int>(bytes, result_pos + sizeof(int64_t), changedRes.row_assignment[1]);
+      BOOST_CHECK( !restores(bytes) );
+
+      /* a result d vector one entry short */
+      bytes = valid.substr(0, valid.size() - vector_bytes);
+      const int64_t short_size = n - 1;
+      bytes.append(reinterpret_cast<const char*>(&short_size), sizeof(short_size));
+      bytes.append(reinterpret_cast<const char*>(changedRes.d.data()), (n - 1) * sizeof(int));
+      BOOST_CHECK( !restores(bytes) );
+
+      /* a result d vector claiming more entries than the dimension */
+      bytes = valid;
+      patch<int64_t>(bytes, valid.size() - vector_bytes, n + 1);
+      BOOST_CHECK( !restores(bytes) );
+    }
+  }
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct.h>
+#include <daestruct/analysis.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <prettyprint.hpp>
+
+#include "singularityTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    /**
+     * x0 = 1
+     * x0 = 2
+     * x1 + x2 + x3 = 0
+     * x2 - x3 = 0
+     */
+    void setSingularIncidence(InputProblem& p) {
+      p.sigma.insert(0, 0, 0);
+      p.sigma.insert(1, 0, 0);
+      p.sigma.insert(2, 1, 0);
+      p.sigma.insert(2, 2, 0);
+      p.sigma.insert(2, 3, 0);
+      p.sigma.insert(3, 2, 0);
+      p.sigma.insert(3, 3, -1);
+    }
+
+    void test_dulmage_mendelsohn() {
+      InputProblem p(4);
+      setSingularIncidence(p);
+
+      const DulmageMendelsohn dm = dulmageMendelsohn(p.sigma);
+      BOOST_CHECK_EQUAL( dm.rank, 3 );
+      BOOST_CHECK_EQUAL( dm.over_equations, std::vector<int>({0, 1}) );
+      BOOST_CHECK_EQUAL( dm.over_variables, std::vector<int>({0}) );
+      BOOST_CHECK_EQUAL( dm.under_equations, std::vector<int>({2, 3}) );
+      BOOST_CHECK_EQUAL( dm.under_variables, std::vector<int>({1, 2, 3}) );
+      BOOST_CHECK( dm.well_equations.empty() );
+      BOOST_CHECK( dm.well_variables.empty() );
+    }
+
+    void test_dulmage_mendelsohn_regular() {
+      InputProblem pendulum(3);
+      pendulum.sigma.insert(0, 0, 0);
+      pendulum.sigma.insert(0, 1, 0);
+      pendulum.sigma.insert(1, 0, -2);
+      pendulum.sigma.insert(1, 2, 0);
+      pendulum.sigma.insert(2, 1, -2);
+      pendulum.sigma.insert(2, 2, 0);
+
+      const DulmageMendelsohn dm = dulmageMendelsohn(pendulum.sigma);
+      BOOST_CHECK_EQUAL( dm.rank, 3 );
+      BOOST_CHECK( dm.over_equations.empty() );
+      BOOST_CHECK( dm.under_variables.empty() );
+      BOOST_CHECK_EQUAL( dm.well_equations, std::vector<int>({0, 1, 2}) );
+    }
+
+    void test_singular_analysis() {
+      InputProblem p(4);
+      setSingularIncidence(p);
+      BOOST_CHECK_THROW( p.pryceAlgorithm(), StructurallySingular );
+
+      p.options.eliminate = false;
+      p.options.fast_path = false;
+      BOOST_CHECK_THROW( p.pryceAlgorithm(), StructurallySingular );
+
+      struct daestruct_input* input = daestruct_input_create(4);
+      daestruct_input_set(input, 0, 0, 0);
+      daestruct_input_set(input, 0, 1, 0);
+      daestruct_input_set(input, 1, 2, 0);
+      daestruct_input_set(input, 2, 2, 0);
+      daestruct_input_set(input, 3, 2, 0);
+      daestruct_input_set(input, 2, 3, 0);
+      daestruct_input_set(input, 3, 3, 1);
+      BOOST_CHECK( daestruct_analyse(input) == nullptr );
+      daestruct_input_delete(input);
+    }
+  }
+}
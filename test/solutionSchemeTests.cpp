@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct.h>
+#include <daestruct/solution_scheme.h>
+#include <daestruct/analysis.hpp>
+#include <daestruct/solution_scheme.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <prettyprint.hpp>
+
+#include "solutionSchemeTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    void test_scheme_pendulum() {
+      AnalysisResult res;
+      res.c = {2, 0, 0};
+      res.d = {2, 2, 0};
+
+      const SolutionScheme scheme = solutionScheme(res);
+      BOOST_CHECK_EQUAL( scheme.first_stage, -2 );
+      BOOST_CHECK_EQUAL( scheme.stages(), 3 );
+      BOOST_CHECK_EQUAL( scheme.equations, std::vector<int>({0, 1, 2}) );
+      BOOST_CHECK_EQUAL( scheme.equation_count, std::vector<int>({1, 1, 3}) );
+      BOOST_CHECK_EQUAL( scheme.variables, std::vector<int>({0, 1, 2}) );
+      BOOST_CHECK_EQUAL( scheme.variable_count, std::vector<int>({2, 2, 3}) );
+      BOOST_CHECK_EQUAL( scheme.dof, 2 );
+    }
+
+    void test_scheme_modelica_pendulum() {
+      /* x² + y² = 1, der(x) = vx, der(y) = vy, der(vx) = F*x, der(vy) = F*y - g */
+      struct daestruct_input* pendulum = daestruct_input_create(5);
+      daestruct_input_set(pendulum, 0, 0, 0);
+      daestruct_input_set(pendulum, 1, 0, 0);
+      daestruct_input_set(pendulum, 0, 1, 1);
+      daestruct_input_set(pendulum, 2, 1, 0);
+      daestruct_input_set(pendulum, 1, 2, 1);
+      daestruct_input_set(pendulum, 3, 2, 0);
+      daestruct_input_set(pendulum, 0, 3, 0);
+      daestruct_input_set(pendulum, 2, 3, 1);
+      daestruct_input_set(pendulum, 4, 3, 0);
+      daestruct_input_set(pendulum, 1, 4, 0);
+      daestruct_input_set(pendulum, 3, 4, 1);
+      daestruct_input_set(pendulum, 4, 4, 0);
+
+      struct daestruct_result* res = daestruct_analyse(pendulum);
+      struct daestruct_scheme* scheme = daestruct_scheme_create(res);
+
+      BOOST_CHECK_EQUAL( daestruct_scheme_first_stage(scheme), -2 );
+      BOOST_CHECK_EQUAL( daestruct_scheme_dof(scheme), 2 );
+
+      /* at the last stage, everything is active */
+      const int* equations;
+      BOOST_CHECK_EQUAL( daestruct_scheme_equations(scheme, 0, &equations), 5 );
+      const int* variables;
+      BOOST_CHECK_EQUAL( daestruct_scheme_variables(scheme, -2, &variables), 2 );
+      for (int k = 0; k < 2; k++)
+	BOOST_CHECK_EQUAL( daestruct_result_variable_index(res, variables[k]), 2 );
+
+      BOOST_CHECK_EQUAL( daestruct_scheme_equations(scheme, -1, &equations), 3 );
+      for (int k = 0; k < 3; k++)
+	BOOST_CHECK( daestruct_result_equation_index(res, equations[k]) >= 1 );
+
+      /* no stages before the first one or after 0 */
+      BOOST_CHECK_EQUAL( daestruct_scheme_equations(scheme, -3, &equations), 0 );
+      BOOST_CHECK( !equations );
+      BOOST_CHECK_EQUAL( daestruct_scheme_variables(scheme, 1, &variables), 0 );
+      BOOST_CHECK( !variables );
+
+      daestruct_scheme_delete(scheme);
+      daestruct_result_delete(res);
+      daestruct_input_delete(pendulum);
+    }
+  }
+}
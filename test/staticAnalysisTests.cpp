@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compiled as C++17 (the library itself is C++11): the static_asserts are
+ * checked by the compiler, main() compares random models against the
+ * dense engine of the library.
+ */
+
+#include <daestruct.h>
+#include <daestruct/static_analysis.hpp>
+
+#include <cstdio>
+#include <random>
+
+using namespace daestruct::analysis;
+
+/* x² + y² = L², der(der(x)) = F x, der(der(y)) = F y - g in x, y, F */
+constexpr auto pendulum = staticAnalysis<3>({{ {{0, 0, -1}}, {{2, -1, 0}}, {{-1, 2, 0}} }});
+static_assert(pendulum.regular, "the pendulum is regular");
+static_assert(pendulum.c[0] == 2 && pendulum.c[1] == 0 && pendulum.c[2] == 0, "c of the pendulum");
+static_assert(pendulum.d[0] == 2 && pendulum.d[1] == 2 && pendulum.d[2] == 0, "d of the pendulum");
+
+/* the maximal offset is the differentiation index minus one for this model */
+constexpr int maxOffset(const std::array<int, 3>& c) {
+  int m = 0;
+  for (int x : c)
+    m = x > m ? x : m;
+  return m;
+}
+static_assert(maxOffset(pendulum.c) + 1 == 3, "index 3 pendulum");
+
+constexpr auto singular = staticAnalysis<3>({{ {{0, -1, -1}}, {{1, -1, -1}}, {{0, 0, 0}} }});
+static_assert(!singular.regular, "two equations in one variable");
+
+template<std::size_t N>
+static int compareRandom(unsigned int seed) {
+  std::mt19937 gen(seed);
+  StaticDerivatives<N> sigma;
+  for (auto& row : sigma)
+    for (auto& x : row)
+      x = gen() % 3 ? -1 : gen() % 4;
+
+  const StaticResult<N> res = staticAnalysis<N>(sigma);
+
+  int c[N], d[N];
+  const int expected = daestruct_analyse_dense(N, &sigma[0][0], c, d);
+  if ((expected == 0) != res.regular)
+    return 1;
+  for (std::size_t k = 0; res.regular && k < N; k++)
+    if (res.c[k] != c[k] || res.d[k] != d[k])
+      return 1;
+  return 0;
+}
+
+int main() {
+  int failures = 0;
+  for (unsigned int seed = 0; seed < 200; seed++)
+    failures += compareRandom<4>(seed) + compareRandom<9>(seed) + compareRandom<16>(seed);
+
+  std::printf("%d failures in the static analysis\n", failures);
+  return failures != 0;
+}
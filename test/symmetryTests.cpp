@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis.hpp>
+#include <daestruct/composite.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <random>
+#include <prettyprint.hpp>
+
+#include "symmetryTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    void test_symmetry_circuit() {
+      ComponentTemplate sub(8, 8, 1);
+      sub.set(0, 0, 0); sub.set(0, 3, 0);
+      sub.set(1, 1, 0); sub.set(1, 4, 0);
+      sub.set(2, 2, 0); sub.set(2, 5, 1);
+      sub.set(3, 3, 0); sub.set(3, 4, 0); sub.set(3, 5, 0);
+      sub.set(4, 2, 0); sub.set(4, 1, 0);
+      sub.set(5, 7, 0); sub.set(5, 6, 1);
+      sub.set(6, 6, 0); sub.set(6, 0, 0); sub.set(6, 1, 0);
+      sub.setInterface(7, 0, 0); sub.set(7, 3, 0); sub.set(7, 7, 0);
+
+      CompositeProblem circuit;
+      const int component = circuit.addTemplate(sub);
+      const int u0 = circuit.addVariable(), i0 = circuit.addVariable();
+      const int source = circuit.addEquation(), loop = circuit.addEquation();
+      circuit.set(source, u0, 0);
+      circuit.set(loop, u0, 0);
+
+      const int n = 50;
+      for (int k = 0; k < n; k++) {
+	const int s = circuit.instantiate(component, {i0});
+	circuit.set(loop, circuit.variable(s, 0), 0);
+	circuit.set(loop, circuit.variable(s, 2), 0);
+      }
+
+      InputProblem flat = circuit.flatten();
+      const AnalysisResult expected = flat.pryceAlgorithm();
+
+      flat.options.symmetry = true;
+      const AnalysisResult res = flat.pryceAlgorithm();
+      BOOST_CHECK_EQUAL( res.c, expected.c );
+      BOOST_CHECK_EQUAL( res.d, expected.d );
+
+      BOOST_CHECK_EQUAL( res.stats.replicated_rows, 8 * n );
+      BOOST_CHECK( res.stats.lap_dimension <= 3 );
+    }
+
+    void test_symmetry_random() {
+      for (unsigned int seed = 0; seed < 50; seed++) {
+	mt19937 gen(seed);
+	uniform_int_distribution<int> der(0, 2);
+
+	const int block = 4, copies = 20, coupling = 2, n = block * copies + coupling;
+
+	std::vector<std::pair<int, int>> entries;
+	std::vector<int> values;
+	for (int i = 0; i < block; i++) {
+	  entries.push_back(make_pair(i, i));
+	  entries.push_back(make_pair(i, (i + 1 + gen() % (block - 1)) % block));
+	}
+	for (unsigned int e = 0; e < entries.size(); e++)
+	  values.push_back(der(gen));
+
+	InputProblem p(n);
+	for (int k = 0; k < copies; k++) {
+	  for (unsigned int e = 0; e < entries.size(); e++)
+	    p.sigma.insert(k * block + entries[e].first, k * block + entries[e].second, -values[e]);
+	}
+
+	/* coupling rows and columns touch every copy */
+	for (int c = 0; c < coupling; c++) {
+	  const int g = block * copies + c;
+	  p.sigma.insert(g, g, -der(gen));
+	  for (int k = 0; k < copies; k++) {
+	    p.sigma.insert(g, k * block + gen() % block, -der(gen));
+	    p.sigma.insert(k * block + gen() % block, g, -der(gen));
+	  }
+	}
+
+	AnalysisResult expected;
+	try {
+	  expected = p.pryceAlgorithm();
+	} catch (const StructurallySingular&) {
+	  p.options.symmetry = true;
+	  BOOST_CHECK_THROW( p.pryceAlgorithm(), StructurallySingular );
+	  continue;
+	}
+
+	p.options.symmetry = true;
+	const AnalysisResult res = p.pryceAlgorithm();
+	BOOST_CHECK_EQUAL( res.c, expected.c );
+	BOOST_CHECK_EQUAL( res.d, expected.d );
+	BOOST_CHECK_EQUAL( res.stats.replicated_rows, block * copies );
+      }
+    }
+  }
+}
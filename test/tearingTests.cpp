@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2014 uebb.tu-berlin.de.
+ *
+ * This file is part of daestruct
+ *
+ * daestruct is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * daestruct is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <daestruct/analysis.hpp>
+#include <daestruct/tearing.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <prettyprint.hpp>
+
+#include "eliminationTests.hpp"
+#include "tearingTests.hpp"
+
+namespace daestruct {
+  namespace test {
+
+    using namespace std;
+    using namespace daestruct::analysis;
+
+    /**
+     * every block variable is torn or solved once, every solved equation
+     * only uses tears and variables solved before
+     */
+    void checkTearing(const InputProblem& p, const AnalysisResult& res, const Tearing& t) {
+      const int n = p.dimension;
+      const BLT& blt = res.blt;
+      BOOST_REQUIRE_EQUAL( t.blocks(), blt.blocks() );
+
+      std::vector<int> blockOf(n);
+      for (int b = 0; b < blt.blocks(); b++)
+	for (int k = blt.block_start[b]; k < blt.block_start[b + 1]; k++)
+	  blockOf[blt.variables[k]] = b;
+
+      std::vector<bool> known(n, false);
+      for (int b = 0; b < t.blocks(); b++) {
+	for (int k = t.tear_start[b]; k < t.tear_start[b + 1]; k++) {
+	  BOOST_CHECK( !known[t.tears[k]] );
+	  known[t.tears[k]] = true;
+	}
+
+	for (int k = t.order_start[b]; k < t.order_start[b + 1]; k++) {
+	  const int i = t.equations[k];
+	  auto row_iter = p.sigma.findRow(i);
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++) {
+	    const int j = col_iter.index2();
+	    if (-*col_iter == res.d[j] - res.c[i] && blockOf[j] == b && j != t.variables[k])
+	      BOOST_CHECK( known[j] );
+	  }
+	  BOOST_CHECK( !known[t.variables[k]] );
+	  known[t.variables[k]] = true;
+	}
+
+	const int size = blt.blockSize(b);
+	BOOST_CHECK_EQUAL( (t.tear_start[b + 1] - t.tear_start[b]) + (t.order_start[b + 1] - t.order_start[b]), size );
+      }
+      BOOST_CHECK_EQUAL( t.tears.size(), t.residuals.size() );
+    }
+
+    void test_tearing_loop() {
+      /*
+       * x = 1
+       * y = x
+       * z + w = y
+       * z - w = 0
+       */
+      InputProblem p(4);
+      p.sigma.insert(0, 0, 0);
+      p.sigma.insert(1, 0, 0);
+      p.sigma.insert(1, 1, 0);
+      p.sigma.insert(2, 1, 0);
+      p.sigma.insert(2, 2, 0);
+      p.sigma.insert(2, 3, 0);
+      p.sigma.insert(3, 2, 0);
+      p.sigma.insert(3, 3, 0);
+      p.options.blt = true;
+
+      const AnalysisResult res = p.pryceAlgorithm();
+      const Tearing t = tearing(p.sigma, res);
+
+      BOOST_CHECK_EQUAL( t.blocks(), 3 );
+      BOOST_CHECK_EQUAL( t.tears, std::vector<int>({2}) );
+      BOOST_CHECK_EQUAL( t.variables, std::vector<int>({0, 1, 3}) );
+      /* either loop equation is solved for w, the other one is the residual */
+      BOOST_REQUIRE_EQUAL( t.residuals.size(), 1u );
+      BOOST_CHECK_EQUAL( t.equations[2] + t.residuals[0], 5 );
+      checkTearing(p, res, t);
+    }
+
+    void test_tearing_random() {
+      for (unsigned int seed = 0; seed < 100; seed++) {
+	InputProblem p(1 + seed % 60);
+	setRandomIncidence(p, seed, 2, 0);
+	p.options.blt = true;
+
+	const AnalysisResult res = p.pryceAlgorithm();
+	checkTearing(p, res, tearing(p.sigma, res));
+      }
+    }
+  }
+}
@@ -17,12 +17,19 @@
  * along with daestruct. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <daestruct.h>
 #include <daestruct/analysis.hpp>
+#include <daestruct/variable_analysis.hpp>
 #include <boost/test/test_tools.hpp>
 #include <prettyprint.hpp>
 
+#include <algorithm>
+#include <random>
+#include <set>
+
 #include "lap.hpp"
 #include "test_lap.hpp"
+#include "eliminationTests.hpp"
 
 namespace daestruct {
   namespace test {
@@ -146,6 +153,42 @@ namespace daestruct {
       BOOST_CHECK_EQUAL( assignment.colsol, std::vector<int>({1,0,2}) );      
     }
     
+    void test_LAP_delta_changed_problem() {
+      using namespace daestruct::analysis;
+
+      for (unsigned int seed = 0; seed < 20; seed++) {
+	const int n = 40;
+	InputProblem original(n);
+	setRandomIncidence(original, seed, 1 + seed % 3, 2);
+	const AnalysisResult res = original.pryceAlgorithm();
+
+	/* replace some equations by a differentiated and extended copy, their columns become unassigned */
+	std::mt19937 gen(seed);
+	StructChange change;
+	change.newVars = 0;
+	for (int k = 0; k < 5; k++)
+	  change.deletedRows.insert(gen() % n);
+	for (const int i : change.deletedRows) {
+	  NewRow row;
+	  auto row_iter = original.sigma.findRow(i);
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	    row.ex_vars[col_iter.index2()] = *col_iter - static_cast<int>(gen() % 2);
+	  row.ex_vars.insert(std::make_pair(static_cast<int>(gen() % n), -static_cast<int>(gen() % 3)));
+	  change.newRows.push_back(row);
+	}
+
+	const ChangedProblem changed(original, res, change);
+	const AnalysisResult delta = changed.pryceAlgorithm();
+
+	InputProblem flat(n);
+	flat.sigma = changed.sigma;
+	const AnalysisResult expected = flat.pryceAlgorithm();
+
+	BOOST_CHECK_EQUAL( delta.c, expected.c );
+	BOOST_CHECK_EQUAL( delta.d, expected.d );
+      }
+    }
+
     void test_LAP_taxi_example() {
       sigma_matrix sigma ( 5 );
 
@@ -263,5 +306,308 @@ namespace daestruct {
       BOOST_CHECK_EQUAL( assignment3.rowsol, std::vector<int>({0,1,2,3,4}) );
       BOOST_CHECK_EQUAL( assignment3.colsol, std::vector<int>({0,1,2,3,4}) );
     }
+
+    void test_LAP_dual_feasible() {
+      for (unsigned int seed = 0; seed < 20; seed++) {
+	/* a randomly numbered band, large enough for long searches with many queue updates */
+	const int n = 20000;
+	std::mt19937 gen(seed);
+	std::vector<int> rowPerm(n), colPerm(n);
+	for (int k = 0; k < n; k++)
+	  rowPerm[k] = colPerm[k] = k;
+	for (int k = n - 1; k > 0; k--) {
+	  std::swap(rowPerm[k], rowPerm[gen() % (k + 1)]);
+	  std::swap(colPerm[k], colPerm[gen() % (k + 1)]);
+	}
+
+	std::vector<std::vector<std::pair<int, int>>> rows(n);
+	for (int i = 0; i < n; i++)
+	  for (int j = std::max(0, i - 3); j <= std::min(n - 1, i + 3); j++)
+	    if (j == i || gen() % 2)
+	      rows[rowPerm[i]].push_back(std::make_pair(colPerm[j], -(int)(gen() % 3)));
+
+	sigma_matrix sigma(n);
+	for (int i = 0; i < n; i++) {
+	  std::sort(rows[i].begin(), rows[i].end());
+	  for (const auto& entry : rows[i])
+	    sigma.insert(i, entry.first, entry.second);
+	}
+
+	const solution assignment = lap(sigma);
+
+	/* u + v <= cost everywhere and tight on the assignment certifies optimality */
+	int violated = 0, loose = 0;
+	for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++)
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++)
+	    if (assignment.u[col_iter.index1()] + assignment.v[col_iter.index2()] > *col_iter)
+	      violated++;
+	for (int i = 0; i < n; i++)
+	  if (assignment.u[i] + assignment.v[assignment.rowsol[i]] != sigma(i, assignment.rowsol[i]))
+	    loose++;
+
+	BOOST_CHECK_EQUAL( violated, 0 );
+	BOOST_CHECK_EQUAL( loose, 0 );
+      }
+    }
+
+    void test_LAP_scanned_columns() {
+      /* relaxing a scanned column again used to end in an assignment of cost -4 */
+      const int n = 6;
+      const int cost[n][n] = {
+	{ -2,  1,  0,  1, -1,  1 },
+	{  0, -1, -1,  1,  1,  1 },
+	{ -2, -1,  0,  1,  1,  1 },
+	{ -2,  1,  1, -1,  1,  1 },
+	{  1,  1,  1,  1,  0,  1 },
+	{  0,  0,  1, -2, -1, -2 }
+      };
+
+      sigma_matrix sigma(n);
+      for (int i = 0; i < n; i++)
+	for (int j = 0; j < n; j++)
+	  if (cost[i][j] <= 0)
+	    sigma.insert(i, j, cost[i][j]);
+
+      const solution assignment = lap(sigma);
+
+      int total = 0;
+      for (int i = 0; i < n; i++) {
+	BOOST_REQUIRE( cost[i][assignment.rowsol[i]] <= 0 );
+	total += cost[i][assignment.rowsol[i]];
+      }
+      BOOST_CHECK_EQUAL( total, -7 );
+    }
+
+    void test_LAP_compact() {
+      for (unsigned int seed = 0; seed < 20; seed++) {
+	const int n = 50 + 10 * seed;
+	std::mt19937 gen(seed);
+
+	sigma_matrix sigma(n);
+	for (int i = 0; i < n; i++) {
+	  std::set<int> columns({static_cast<int>((i + seed) % n)});
+	  for (int k = gen() % 4; k > 0; k--)
+	    columns.insert(gen() % n);
+	  for (int j : columns)
+	    sigma.insert(i, j, -(int)(gen() % 4));
+	}
+
+	BOOST_REQUIRE( compact_sigma_matrix::represents(sigma) );
+	const compact_sigma_matrix compact = compact_sigma_matrix::copy(sigma);
+	BOOST_CHECK_EQUAL( compact.nnz(), sigma.nnz() );
+
+	const solution expected = lap(sigma);
+	const solution assignment = lap(compact);
+	BOOST_CHECK_EQUAL( assignment.cost, expected.cost );
+
+	std::vector<int> c(n, 0), d(n, 0), expected_c(n, 0), expected_d(n, 0);
+	analysis::solveByFixedPoint(expected.rowsol, sigma, expected_c, expected_d);
+	analysis::solveByFixedPoint(assignment.rowsol, compact, c, d);
+	BOOST_CHECK_EQUAL( c, expected_c );
+	BOOST_CHECK_EQUAL( d, expected_d );
+      }
+
+      sigma_matrix deep(2);
+      deep.insert(0, 0, -200);
+      deep.insert(1, 1, 0);
+      BOOST_CHECK( !compact_sigma_matrix::represents(deep) );
+      BOOST_CHECK_THROW( compact_sigma_matrix::copy(deep), std::invalid_argument );
+
+      compact_sigma_matrix compact(2);
+      BOOST_CHECK_THROW( compact.insert(0, 0, 128), std::invalid_argument );
+      BOOST_CHECK_EQUAL( compact.nnz(), 0u );
+    }
+
+    void test_LAP_packed() {
+      for (unsigned int seed = 0; seed < 20; seed++) {
+	/* wide enough for column distances of three varint bytes */
+	const int n = seed % 2 ? 100 + seed : 30000 + seed;
+	std::mt19937 gen(seed);
+
+	sigma_matrix sigma(n);
+	for (int i = 0; i < n; i++) {
+	  if (i == n / 2)
+	    continue;
+	  std::set<int> columns({static_cast<int>((i + seed) % n)});
+	  for (int k = gen() % 4; k > 0; k--)
+	    columns.insert(gen() % n);
+	  for (int j : columns)
+	    sigma.insert(i, j, -(int)(gen() % 4));
+	}
+
+	const packed_sigma_matrix packed(sigma);
+	BOOST_CHECK_EQUAL( packed.nnz(), sigma.nnz() );
+
+	/* the same entries in the same order, the empty row included */
+	int mismatches = 0;
+	auto packed_row = packed.rowBegin();
+	for (auto row_iter = sigma.rowBegin(); row_iter != sigma.rowEnd(); row_iter++) {
+	  while (packed_row.index1() < (int)row_iter.index1())
+	    packed_row++;
+	  auto packed_col = packed_row.begin();
+	  for (auto col_iter = row_iter.begin(); col_iter != row_iter.end(); col_iter++, packed_col++)
+	    if (packed_col == packed_row.end() || packed_col.index2() != (int)col_iter.index2() || *packed_col != *col_iter)
+	      mismatches++;
+	  if (packed_col != packed_row.end())
+	    mismatches++;
+	}
+	BOOST_CHECK_EQUAL( mismatches, 0 );
+	BOOST_CHECK_EQUAL( packed(n / 2, 0), BIG );
+
+	/* the empty row makes it singular, give it a diagonal entry in both */
+	sigma.insert(n / 2, (n / 2 + seed) % n, 0);
+	const packed_sigma_matrix complete(sigma);
+
+	const solution expected = lap(sigma);
+	const solution assignment = lap(complete);
+	BOOST_CHECK_EQUAL( assignment.cost, expected.cost );
+
+	std::vector<int> c(n, 0), d(n, 0), expected_c(n, 0), expected_d(n, 0);
+	analysis::solveByFixedPoint(expected.rowsol, sigma, expected_c, expected_d);
+	analysis::solveByFixedPoint(assignment.rowsol, complete, c, d);
+	BOOST_CHECK_EQUAL( c, expected_c );
+	BOOST_CHECK_EQUAL( d, expected_d );
+      }
+    }
+
+    void test_LAP_cost_overflow() {
+      const int n = 3;
+      sigma_matrix sigma(n);
+      for (int i = 0; i < n; i++)
+	for (int j = 0; j < n; j++)
+	  sigma.insert(i, j, i == j ? -800000000 : 0);
+
+      const solution assignment = lap(sigma);
+      BOOST_CHECK_EQUAL( assignment.cost, -2400000000LL );
+      BOOST_CHECK_EQUAL( assignment.rowsol, std::vector<int>({0, 1, 2}) );
+    }
+
+    void test_LAP_dense() {
+      const std::vector<int> taxi({12,  8, 11, 18, 11,
+				   14, 22,  8, 12, 14,
+				   14, 14, 16, 14, 15,
+				   19, 11, 14, 17, 15,
+				   13,  9, 17, 20, 11});
+      const solution assignment = dense_lap(5, taxi);
+      BOOST_CHECK_EQUAL( assignment.rowsol, std::vector<int>({0,2,3,1,4}) );
+      BOOST_CHECK_EQUAL( assignment.colsol, std::vector<int>({0,3,1,2,4}) );
+
+      std::mt19937 gen(0);
+      for (unsigned int seed = 0; seed < 40; seed++) {
+	const int n = 50 + 3 * seed;
+	const double density = 0.05 + (seed % 8) * 0.13;
+
+	sigma_matrix sigma(n);
+	std::vector<int> cost(n * n, BIG);
+	for (int i = 0; i < n; i++)
+	  for (int j = 0; j < n; j++)
+	    if (j == static_cast<int>((i + seed) % n) || std::generate_canonical<double, 32>(gen) < density) {
+	      const int value = -static_cast<int>(gen() % 5);
+	      sigma.insert(i, j, value);
+	      cost[i * n + j] = value;
+	    }
+
+	const solution expected = lap(sigma);
+	const solution dense = dense_lap(n, cost);
+	BOOST_CHECK_EQUAL( dense.cost, expected.cost );
+
+	/* complementary slackness certifies optimality */
+	for (int i = 0; i < n; i++) {
+	  BOOST_CHECK_EQUAL( dense.colsol[dense.rowsol[i]], i );
+	  for (int j = 0; j < n; j++)
+	    if (cost[i * n + j] < BIG)
+	      BOOST_CHECK( dense.u[i] + dense.v[j] <= cost[i * n + j] );
+	  BOOST_CHECK_EQUAL( dense.u[i] + dense.v[dense.rowsol[i]], cost[i * n + dense.rowsol[i]] );
+	}
+      }
+    }
+
+    /* the rows of a model in its own representation, derivatives per equation */
+    struct callback_model {
+      std::vector<std::vector<int>> variables;
+      std::vector<std::vector<int>> derivatives;
+
+      static int rows(void* data, int equation, const int** variables, const int** derivatives) {
+	const callback_model* model = static_cast<const callback_model*>(data);
+	*variables = model->variables[equation].data();
+	*derivatives = model->derivatives[equation].data();
+	return model->variables[equation].size();
+      }
+    };
+
+    void test_LAP_row_matrices() {
+      for (unsigned int seed = 0; seed < 20; seed++) {
+	const int n = 20 + 37 * seed;
+	std::mt19937 gen(seed);
+
+	sigma_matrix sigma(n);
+	callback_model model;
+	model.variables.resize(n);
+	model.derivatives.resize(n);
+	std::vector<int64_t> row_start(1, 0);
+	std::vector<int> columns, costs;
+	for (int i = 0; i < n; i++) {
+	  std::set<int> row({static_cast<int>((i + seed) % n)});
+	  for (int k = gen() % 4; k > 0; k--)
+	    row.insert(gen() % n);
+	  std::vector<int> shuffled(row.begin(), row.end());
+	  std::shuffle(shuffled.begin(), shuffled.end(), gen);
+	  for (int j : shuffled) {
+	    const int derivative = gen() % 4;
+	    sigma.insert(i, j, -derivative);
+	    columns.push_back(j);
+	    costs.push_back(-derivative);
+	    model.variables[i].push_back(j);
+	    model.derivatives[i].push_back(derivative);
+	  }
+	  row_start.push_back(columns.size());
+	}
+
+	const csr_matrix csr(n, row_start.data(), columns.data(), costs.data());
+	const callback_matrix rows(n, &callback_model::rows, &model, true);
+	BOOST_CHECK_EQUAL( rowCost(csr, 0, columns[0]), sigma(0, columns[0]) );
+	BOOST_CHECK_EQUAL( rowCost(rows, 0, columns[0]), sigma(0, columns[0]) );
+
+	const solution expected = lap(sigma);
+	BOOST_CHECK_EQUAL( lap(csr).cost, expected.cost );
+	BOOST_CHECK_EQUAL( lap(rows).cost, expected.cost );
+
+	/* free every other row of the optimal assignment */
+	std::vector<int> rowsol(expected.rowsol), colsol(expected.colsol);
+	for (int i = 0; i < n; i += 2) {
+	  colsol[rowsol[i]] = -1;
+	  rowsol[i] = -1;
+	}
+	BOOST_CHECK_EQUAL( delta_lap(csr, expected.u, expected.v, rowsol, colsol).cost, expected.cost );
+	BOOST_CHECK_EQUAL( delta_lap(rows, expected.u, expected.v, rowsol, colsol).cost, expected.cost );
+
+	std::vector<int> expected_c(n, 0), expected_d(n, 0);
+	analysis::solveByFixedPoint(expected.rowsol, sigma, expected_c, expected_d);
+	std::vector<int> c(n, 0), d(n, 0);
+	analysis::solveByFixedPoint(expected.rowsol, csr, c, d);
+	BOOST_CHECK_EQUAL( c, expected_c );
+	BOOST_CHECK_EQUAL( d, expected_d );
+	c.assign(n, 0);
+	d.assign(n, 0);
+	analysis::solveByFixedPoint(expected.rowsol, rows, c, d);
+	BOOST_CHECK_EQUAL( c, expected_c );
+	BOOST_CHECK_EQUAL( d, expected_d );
+
+	BOOST_REQUIRE_EQUAL( daestruct_analyse_rows(n, &callback_model::rows, &model, c.data(), d.data()), 0 );
+	BOOST_CHECK_EQUAL( c, expected_c );
+	BOOST_CHECK_EQUAL( d, expected_d );
+
+	/* an unknown out of range */
+	model.variables[n / 2][0] = n;
+	BOOST_CHECK_EQUAL( daestruct_analyse_rows(n, &callback_model::rows, &model, c.data(), d.data()), -1 );
+	model.variables[n / 2][0] = -1;
+	BOOST_CHECK_EQUAL( daestruct_analyse_rows(n, &callback_model::rows, &model, c.data(), d.data()), -1 );
+
+	/* an equation without unknowns */
+	model.variables[n / 2].clear();
+	model.derivatives[n / 2].clear();
+	BOOST_CHECK_EQUAL( daestruct_analyse_rows(n, &callback_model::rows, &model, c.data(), d.data()), -1 );
+      }
+    }
   }
 }
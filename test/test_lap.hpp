@@ -27,6 +27,11 @@ namespace daestruct {
 
     void test_LAP_delta();
 
+    /**
+     * Incremental analysis of changed equations agrees with the analysis from scratch
+     */
+    void test_LAP_delta_changed_problem();
+
     void test_LAP_better_delta();
 
     void test_LAP_taxi_example();
@@ -35,6 +40,42 @@ namespace daestruct {
 
     void test_LAP_on_identity();
 
+    /**
+     * The duals of a large sparse problem certify the optimality of the assignment
+     */
+    void test_LAP_dual_feasible();
+
+    /**
+     * Columns already moved to the scan list must not be relaxed again
+     */
+    void test_LAP_scanned_columns();
+
+    /**
+     * lap() and the fixpoint on int8 costs with 32 bit indices agree with the default representation,
+     * costs beyond int8 are rejected
+     */
+    void test_LAP_compact();
+
+    /**
+     * Varint compressed rows decode to the entries of sigma and give the same analysis
+     */
+    void test_LAP_packed();
+
+    /**
+     * The optimal cost is summed without overflow when it exceeds the range of int
+     */
+    void test_LAP_cost_overflow();
+
+    /**
+     * dense_lap() on the taxi example and on random problems of any density, against lap()
+     */
+    void test_LAP_dense();
+
+    /**
+     * lap(), delta_lap() and the fixpoint read CSR arrays and callback rows in place, like sigma_matrix
+     */
+    void test_LAP_row_matrices();
+
   }
 }
 